@@ -0,0 +1,111 @@
+#define BC_BUILDING_LIBRARY
+#include "base_conversion_c.h"
+
+#include "base_conversion/buffer.hpp"
+
+#include <span>
+#include <string_view>
+
+using namespace evqovv::base_conversion;
+
+namespace {
+auto valid_base(bc_base radix) noexcept -> bool {
+    return radix >= BC_BINARY && radix <= BC_HEXADECIMAL;
+}
+
+auto to_status(conversion_errc ec) noexcept -> bc_status {
+    switch (ec) {
+    case conversion_errc::ok:
+        return BC_OK;
+    case conversion_errc::empty_string:
+        return BC_EMPTY_INPUT;
+    case conversion_errc::invalid_character:
+        return BC_INVALID_CHARACTER;
+    case conversion_errc::overflow:
+        return BC_OVERFLOW;
+    case conversion_errc::buffer_too_small:
+        return BC_BUFFER_TOO_SMALL;
+    }
+    return BC_INVALID_ARGUMENT;
+}
+
+auto convert_one(bc_base from, bc_base to, char const *in, std::size_t in_len,
+                 char *out, std::size_t out_cap, std::size_t *out_len) noexcept
+    -> bc_status {
+    if ((in == nullptr && in_len != 0) || (out == nullptr && out_cap != 0)) {
+        return BC_INVALID_ARGUMENT;
+    }
+
+    auto const result =
+        convert_into(static_cast<base>(from), static_cast<base>(to),
+                     std::string_view(in, in_len), std::span(out, out_cap));
+    if (out_len != nullptr) {
+        *out_len = result.size;
+    }
+    return to_status(result.ec);
+}
+} // namespace
+
+extern "C" {
+BC_API auto bc_version() -> unsigned {
+    return (BC_VERSION_MAJOR << 16) | BC_VERSION_MINOR;
+}
+
+BC_API auto bc_status_string(bc_status status) -> char const * {
+    switch (status) {
+    case BC_OK:
+        return "ok";
+    case BC_EMPTY_INPUT:
+        return "input is empty";
+    case BC_INVALID_CHARACTER:
+        return "invalid character in input";
+    case BC_OVERFLOW:
+        return "value exceeds uint64_t limit";
+    case BC_BUFFER_TOO_SMALL:
+        return "output buffer too small";
+    case BC_INVALID_BASE:
+        return "invalid base";
+    case BC_INVALID_ARGUMENT:
+        break;
+    }
+    return "invalid argument";
+}
+
+BC_API auto bc_max_output_size(bc_base from, bc_base to, size_t in_len)
+    -> size_t {
+    if (!valid_base(from) || !valid_base(to)) {
+        return 0;
+    }
+    return max_output_size(static_cast<base>(from), static_cast<base>(to),
+                           in_len);
+}
+
+BC_API auto bc_convert(bc_base from, bc_base to, char const *in, size_t in_len,
+                       char *out, size_t out_cap, size_t *out_len)
+    -> bc_status {
+    if (!valid_base(from) || !valid_base(to)) {
+        return BC_INVALID_BASE;
+    }
+    return convert_one(from, to, in, in_len, out, out_cap, out_len);
+}
+
+BC_API auto bc_convert_batch(bc_base from, bc_base to, bc_batch_item *items,
+                             size_t count) -> bc_status {
+    if (!valid_base(from) || !valid_base(to)) {
+        return BC_INVALID_BASE;
+    }
+    if (items == nullptr && count != 0) {
+        return BC_INVALID_ARGUMENT;
+    }
+
+    auto first_failure = BC_OK;
+    for (auto &item : std::span(items, count)) {
+        item.status = convert_one(from, to, item.in, item.in_len, item.out,
+                                  item.out_cap, &item.out_len);
+        if (item.status != BC_OK && first_failure == BC_OK) {
+            first_failure = item.status;
+        }
+    }
+    return first_failure;
+}
+}
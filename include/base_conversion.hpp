@@ -1,238 +1,116 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <string_view>
-#include <stdexcept>
-#include <cstdint>
-#include <limits>
-#include <array>
-#include <charconv>
-#include <utility>
-#include <format>
+
+#include "base_conversion/base.hpp"
+
+// With EVQOVV_BASE_CONVERSION_SEPARATE_COMPILATION defined this header only
+// declares the conversions, which are then linked from base_conversion_kernels;
+// otherwise everything is defined inline below.
+#ifdef EVQOVV_BASE_CONVERSION_SEPARATE_COMPILATION
+#define EVQOVV_BASE_CONVERSION_DECL
+#else
+#define EVQOVV_BASE_CONVERSION_DECL inline
+#endif
 
 namespace evqovv {
 namespace base_conversion {
-namespace details {
-enum class base : unsigned char {
-    binary,
-    octal,
-    decimal,
-    hexadecimal,
-};
-
-inline constexpr auto binary_base = 2;
-inline constexpr auto octal_base = 8;
-inline constexpr auto decimal_base = 10;
-inline constexpr auto hexadecimal_base = 16;
-
+EVQOVV_BASE_CONVERSION_DECL auto zero_padding(std::string_view str,
+                                              std::size_t multiple)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto binary_to_octal(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto binary_to_decimal(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto binary_to_hexadecimal(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto octal_to_binary(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto octal_to_decimal(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto octal_to_hexadecimal(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto decimal_to_binary(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto decimal_to_octal(std::string_view str)
+    -> std::string;
 template <bool uppercase = true>
-inline constexpr auto decimal_to_hexadecimal_map(int digit) noexcept -> char {
-    static constexpr std::array<char, 16> upper_chars{
-        '0', '1', '2', '3', '4', '5', '6', '7',
-        '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
-    static constexpr std::array<char, 16> lower_chars{
-        '0', '1', '2', '3', '4', '5', '6', '7',
-        '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
-
-    return uppercase ? upper_chars[digit] : lower_chars[digit];
-}
-
-inline constexpr auto hexadecimal_to_binary_map(int digit) noexcept
-    -> std::string_view {
-    static constexpr std::array<std::string_view, 16> map{
-        "0000", "0001", "0010", "0011", "0100", "0101", "0110", "0111",
-        "1000", "1001", "1010", "1011", "1100", "1101", "1110", "1111",
-    };
-
-    if (digit >= '0' && digit <= '9') {
-        return map[digit - '0'];
-    } else if (digit >= 'A' && digit <= 'F') {
-        return map[digit - 'A' + 10];
-    } else if (digit >= 'a' && digit <= 'f') {
-        return map[digit - 'a' + 10];
-    }
-
-    [[unlikely]] std::unreachable();
-}
-
-inline constexpr auto hexadecimal_to_decimal_map(int digit) noexcept -> int {
-    if (digit <= '9') {
-        return digit - '0';
-    } else if (digit <= 'F') {
-        return digit - 'A' + 10;
-    } else {
-        return digit - 'a' + 10;
-    }
-}
-
-inline constexpr auto octal_to_binary_map(int digit) noexcept
-    -> std::string_view {
-    static constexpr std::array<std::string_view, 8> map{
-        "000", "001", "010", "011", "100", "101", "110", "111"};
-
-    if (digit >= '0' && digit <= '7') {
-        return map[digit - '0'];
-    }
-
-    [[unlikely]] std::unreachable();
-}
-
-inline constexpr auto binary_to_hexadecimal_map(std::string_view str) -> char {
-    static constexpr std::array<std::pair<std::string_view, char>, 16> map{
-        {{"0000", '0'},
-         {"0001", '1'},
-         {"0010", '2'},
-         {"0011", '3'},
-         {"0100", '4'},
-         {"0101", '5'},
-         {"0110", '6'},
-         {"0111", '7'},
-         {"1000", '8'},
-         {"1001", '9'},
-         {"1010", 'A'},
-         {"1011", 'B'},
-         {"1100", 'C'},
-         {"1101", 'D'},
-         {"1110", 'E'},
-         {"1111", 'F'}}};
-
-    for (auto const &[binary, hexadecimal] : map) {
-        if (str == binary) {
-            return hexadecimal;
-        }
-    }
-
-    [[unlikely]] std::unreachable();
-}
-
-inline constexpr auto binary_to_octal_map(std::string_view str) -> char {
-    static constexpr std::array<std::pair<std::string_view, char>, 16> map{
-        {{"000", '0'},
-         {"001", '1'},
-         {"010", '2'},
-         {"011", '3'},
-         {"100", '4'},
-         {"101", '5'},
-         {"110", '6'},
-         {"111", '7'}}};
-
-    for (auto const &[binary, octal] : map) {
-        if (str == binary) {
-            return octal;
-        }
-    }
-
-    [[unlikely]] std::unreachable();
-}
-
-inline auto throw_invalid_character_error(char invalid_char) -> void {
-    throw std::invalid_argument(
-        std::format("base conversion error: invalid character '{}' in string",
-                    invalid_char));
-}
-
-inline auto throw_overflow_error() -> void {
-    throw std::overflow_error("base conversion error: the value represented by "
-                              "string exceeds uint64_t limit");
-}
-
-inline auto validate_string(std::string_view str) -> void {
-    if (str.empty()) [[unlikely]] {
-        throw std::invalid_argument("base conversion error: string is empty");
-    }
-}
-
-inline auto validate_binary_character(char ch) -> void {
-    if (ch != '0' && ch != '1') {
-        details::throw_invalid_character_error(ch);
-    }
-}
-
-inline auto validate_octal_character(char ch) -> void {
-    if (ch < '0' || ch > '7') {
-        details::throw_invalid_character_error(ch);
-    }
-}
-
-inline auto validate_hexadecimal_character(char ch) -> void {
-    if (!((ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'F') ||
-          (ch >= 'a' && ch <= 'f'))) {
-        details::throw_invalid_character_error(ch);
-    }
-}
-
-inline auto trim_leading_zeros(std::string_view str) noexcept
-    -> std::string_view {
-    validate_string(str);
-
-    auto const first_non_zero_pos = str.find_first_not_of('0');
-    return (first_non_zero_pos == std::string_view::npos)
-               ? "0"
-               : str.substr(first_non_zero_pos);
-}
-
-inline auto to_uint64_t(std::string_view str) -> uint64_t {
-    uint64_t result{};
-
-    auto [ptr, ec] =
-        std::from_chars(str.data(), str.data() + str.size(), result);
-    if (ec == std::errc::invalid_argument) {
-        details::throw_invalid_character_error(*ptr);
-    }
-    if (ec == std::errc::result_out_of_range) {
-        details::throw_overflow_error();
-    }
-
-    return result;
-}
-
-inline auto validate_binary_string(std::string_view str) -> void {
-    for (auto &&ch : str) {
-        details::validate_binary_character(ch);
-    }
-}
-
-inline auto validate_multiple(std::size_t multiple) -> void {
-    if (multiple == 0) [[unlikely]] {
-        throw std::invalid_argument("base conversion error: multiple is zero");
-    }
-}
+EVQOVV_BASE_CONVERSION_DECL auto decimal_to_hexadecimal(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto hexadecimal_to_binary(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto hexadecimal_to_octal(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto hexadecimal_to_decimal(std::string_view str)
+    -> std::string;
+EVQOVV_BASE_CONVERSION_DECL auto convert(base from, base to,
+                                         std::string_view str) -> std::string;
+
+#ifdef EVQOVV_BASE_CONVERSION_SEPARATE_COMPILATION
+extern template auto decimal_to_hexadecimal<true>(std::string_view str)
+    -> std::string;
+extern template auto decimal_to_hexadecimal<false>(std::string_view str)
+    -> std::string;
+#endif
+} // namespace base_conversion
+} // namespace evqovv
 
-inline auto validate_overflow(uint64_t const &value, int digit, int base) {
-    if (value > (std::numeric_limits<uint64_t>::max() - digit) / base)
-        [[unlikely]] {
-        details::throw_overflow_error();
-    }
-}
-} // namespace details
+#if !defined(EVQOVV_BASE_CONVERSION_SEPARATE_COMPILATION) ||                  \
+    defined(EVQOVV_BASE_CONVERSION_SOURCE)
+#include "base_conversion/details.hpp"
 
-inline auto zero_padding(std::string_view str, std::size_t multiple)
+namespace evqovv {
+namespace base_conversion {
+EVQOVV_BASE_CONVERSION_DECL auto zero_padding(std::string_view str,
+                                              std::size_t multiple)
     -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(zero_padding, str);
+
     details::validate_string(str);
     details::validate_multiple(multiple);
 
     std::string result(str);
     auto const padding_num = (multiple - (result.size() % multiple)) % multiple;
     result.insert(0, padding_num, '0');
-    return result;
+    return EVQOVV_BASE_CONVERSION_COMPLETE(result);
 }
 
+namespace details {
 inline auto binary_to_octal(std::string_view str) -> std::string {
     details::validate_string(str);
     details::validate_binary_string(str);
 
-    auto padded_str = zero_padding(details::trim_leading_zeros(str), 3);
+    auto const digits = details::trim_leading_zeros(str);
+    auto const head = (digits.size() - 1) % 3 + 1;
+    auto const size = (digits.size() + 2) / 3;
 
     std::string result;
-    for (decltype(padded_str.size()) i{}; i != padded_str.size(); i += 3) {
-        result += details::binary_to_octal_map(
-            std::string_view(padded_str).substr(i, 3));
-    }
+    result.resize_and_overwrite(size, [&](char *out, std::size_t) {
+        auto const *in = digits.data();
+        *out++ = static_cast<char>('0' + details::pack_binary(in, head));
+        for (in += head; in != digits.data() + digits.size(); in += 3) {
+            *out++ = static_cast<char>('0' + details::pack_binary(in, 3));
+        }
+        return size;
+    });
+
+    return result;
+}
+} // namespace details
+
+EVQOVV_BASE_CONVERSION_DECL auto binary_to_octal(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(binary_to_octal, str);
 
-    return std::string(details::trim_leading_zeros(result));
+    return EVQOVV_BASE_CONVERSION_COMPLETE(details::binary_to_octal(str));
 }
 
-inline auto binary_to_decimal(std::string_view str) -> std::string {
+EVQOVV_BASE_CONVERSION_DECL auto binary_to_decimal(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(binary_to_decimal, str);
+
     details::validate_string(str);
 
     uint64_t result{};
@@ -246,38 +124,102 @@ inline auto binary_to_decimal(std::string_view str) -> std::string {
         result = result * details::binary_base + digit;
     }
 
-    return std::to_string(result);
+    return EVQOVV_BASE_CONVERSION_COMPLETE(std::to_string(result));
 }
 
+namespace details {
 inline auto binary_to_hexadecimal(std::string_view str) -> std::string {
     details::validate_string(str);
     details::validate_binary_string(str);
 
-    auto padded_str = zero_padding(details::trim_leading_zeros(str), 4);
+    auto const digits = details::trim_leading_zeros(str);
+    auto const head = (digits.size() - 1) % 4 + 1;
+    auto const size = (digits.size() + 3) / 4;
 
     std::string result;
-    for (decltype(padded_str.size()) i{}; i != padded_str.size(); i += 4) {
-        result += details::binary_to_hexadecimal_map(
-            std::string_view(padded_str).substr(i, 4));
-    }
+    result.resize_and_overwrite(size, [&](char *out, std::size_t) {
+        auto const *in = digits.data();
+        auto const *end = in + digits.size();
+        *out++ = details::decimal_to_hexadecimal_map(
+            static_cast<int>(details::pack_binary(in, head)));
+        for (in += head; end - in >= 8;) {
+            if (details::load_word(in) == details::zero_digits) {
+                // Sparse inputs: whole bytes of zeros become "00" pairs.
+                auto const run = details::zero_run_length(
+                                     in, static_cast<std::size_t>(end - in)) /
+                                 8 * 8;
+                std::memset(out, '0', run / 4);
+                in += run;
+                out += run / 4;
+                continue;
+            }
+            std::memcpy(
+                out,
+                details::hexadecimal_pairs[details::pack_binary_byte(in)]
+                    .data(),
+                2);
+            in += 8;
+            out += 2;
+        }
+        if (in != end) {
+            *out = details::decimal_to_hexadecimal_map(
+                static_cast<int>(details::pack_binary(in, 4)));
+        }
+        return size;
+    });
+
+    return result;
+}
+} // namespace details
+
+EVQOVV_BASE_CONVERSION_DECL auto binary_to_hexadecimal(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(binary_to_hexadecimal, str);
 
-    return std::string(details::trim_leading_zeros(result));
+    return EVQOVV_BASE_CONVERSION_COMPLETE(details::binary_to_hexadecimal(str));
 }
 
+namespace details {
 inline auto octal_to_binary(std::string_view str) -> std::string {
     details::validate_string(str);
 
-    std::string result;
-    for (auto &&ch : details::trim_leading_zeros(str)) {
+    auto const digits = details::trim_leading_zeros(str);
+    for (auto &&ch : digits) {
         details::validate_octal_character(ch);
-
-        result += details::octal_to_binary_map(ch);
     }
 
-    return std::string(details::trim_leading_zeros(result));
+    auto const leading = static_cast<unsigned>(digits[0] - '0');
+    auto const head = std::max<std::size_t>(std::bit_width(leading), 1);
+    auto const size = (digits.size() - 1) * 3 + head;
+
+    std::string result;
+    result.resize_and_overwrite(size, [&](char *out, std::size_t) {
+        std::memcpy(out, details::binary_nibbles[leading].data() + 4 - head,
+                    head);
+        out += head;
+        for (auto &&ch : digits.substr(1)) {
+            std::memcpy(out, details::binary_nibbles[ch - '0'].data() + 1,
+                        3);
+            out += 3;
+        }
+        return size;
+    });
+
+    return result;
+}
+} // namespace details
+
+EVQOVV_BASE_CONVERSION_DECL auto octal_to_binary(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(octal_to_binary, str);
+
+    return EVQOVV_BASE_CONVERSION_COMPLETE(details::octal_to_binary(str));
 }
 
-inline auto octal_to_decimal(std::string_view str) -> std::string {
+EVQOVV_BASE_CONVERSION_DECL auto octal_to_decimal(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(octal_to_decimal, str);
+
     details::validate_string(str);
 
     uint64_t result{};
@@ -291,16 +233,30 @@ inline auto octal_to_decimal(std::string_view str) -> std::string {
         result = result * details::octal_base + digit;
     }
 
-    return std::to_string(result);
+    return EVQOVV_BASE_CONVERSION_COMPLETE(std::to_string(result));
 }
 
-inline auto octal_to_hexadecimal(std::string_view str) -> std::string {
+EVQOVV_BASE_CONVERSION_DECL auto octal_to_hexadecimal(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(octal_to_hexadecimal, str);
+
     details::validate_string(str);
 
-    return binary_to_hexadecimal(octal_to_binary(str));
+    if (details::use_direct_transcode(str)) {
+        return EVQOVV_BASE_CONVERSION_COMPLETE(
+            details::transcode<3, 4>(str, details::validate_octal_character,
+                                     [](char ch) { return ch - '0'; }));
+    }
+
+    // The unprobed kernels, so that one call is recorded once.
+    return EVQOVV_BASE_CONVERSION_COMPLETE(
+        details::binary_to_hexadecimal(details::octal_to_binary(str)));
 }
 
-inline auto decimal_to_binary(std::string_view str) -> std::string {
+EVQOVV_BASE_CONVERSION_DECL auto decimal_to_binary(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(decimal_to_binary, str);
+
     details::validate_string(str);
 
     auto value = details::to_uint64_t(details::trim_leading_zeros(str));
@@ -312,10 +268,13 @@ inline auto decimal_to_binary(std::string_view str) -> std::string {
         value /= details::binary_base;
     } while (value != 0);
 
-    return result;
+    return EVQOVV_BASE_CONVERSION_COMPLETE(result);
 }
 
-inline auto decimal_to_octal(std::string_view str) -> std::string {
+EVQOVV_BASE_CONVERSION_DECL auto decimal_to_octal(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(decimal_to_octal, str);
+
     details::validate_string(str);
 
     auto value = details::to_uint64_t(details::trim_leading_zeros(str));
@@ -326,11 +285,14 @@ inline auto decimal_to_octal(std::string_view str) -> std::string {
         value /= details::octal_base;
     } while (value != 0);
 
-    return result;
+    return EVQOVV_BASE_CONVERSION_COMPLETE(result);
 }
 
-template <bool uppercase = true>
-inline auto decimal_to_hexadecimal(std::string_view str) -> std::string {
+template <bool uppercase>
+EVQOVV_BASE_CONVERSION_DECL auto decimal_to_hexadecimal(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(decimal_to_hexadecimal, str);
+
     details::validate_string(str);
 
     auto value = details::to_uint64_t(details::trim_leading_zeros(str));
@@ -343,29 +305,80 @@ inline auto decimal_to_hexadecimal(std::string_view str) -> std::string {
         value /= details::hexadecimal_base;
     } while (value != 0);
 
-    return result;
+    return EVQOVV_BASE_CONVERSION_COMPLETE(result);
 }
 
+namespace details {
 inline auto hexadecimal_to_binary(std::string_view str) -> std::string {
     details::validate_string(str);
 
-    std::string result;
-    for (auto &&ch : details::trim_leading_zeros(str)) {
+    auto const digits = details::trim_leading_zeros(str);
+    for (auto &&ch : digits) {
         details::validate_hexadecimal_character(ch);
-
-        result += details::hexadecimal_to_binary_map(ch);
     }
 
-    return std::string(details::trim_leading_zeros(result));
+    auto const value = [](char ch) {
+        return static_cast<unsigned>(
+            details::hexadecimal_values[static_cast<unsigned char>(ch)]);
+    };
+    auto const leading = value(digits[0]);
+    auto const head = std::max<std::size_t>(std::bit_width(leading), 1);
+
+    // Two digits at a time go out as one eight-character store.
+    auto const size = (digits.size() - 1) * 4 + head;
+
+    std::string result;
+    result.resize_and_overwrite(size, [&](char *out, std::size_t) {
+        std::memcpy(out, details::binary_nibbles[leading].data() + 4 - head,
+                    head);
+        out += head;
+        auto const *in = digits.data() + 1;
+        auto const *end = digits.data() + digits.size();
+        for (; end - in >= 2; in += 2, out += 8) {
+            std::memcpy(out,
+                        details::binary_bytes[value(in[0]) << 4 |
+                                              value(in[1])]
+                            .data(),
+                        8);
+        }
+        if (in != end) {
+            std::memcpy(out, details::binary_nibbles[value(*in)].data(),
+                        4);
+        }
+        return size;
+    });
+
+    return result;
+}
+} // namespace details
+
+EVQOVV_BASE_CONVERSION_DECL auto hexadecimal_to_binary(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(hexadecimal_to_binary, str);
+
+    return EVQOVV_BASE_CONVERSION_COMPLETE(details::hexadecimal_to_binary(str));
 }
 
-inline auto hexadecimal_to_octal(std::string_view str) -> std::string {
+EVQOVV_BASE_CONVERSION_DECL auto hexadecimal_to_octal(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(hexadecimal_to_octal, str);
+
     details::validate_string(str);
 
-    return binary_to_octal(hexadecimal_to_binary(str));
+    if (details::use_direct_transcode(str)) {
+        return EVQOVV_BASE_CONVERSION_COMPLETE(details::transcode<4, 3>(
+            str, details::validate_hexadecimal_character,
+            details::hexadecimal_to_decimal_map));
+    }
+
+    return EVQOVV_BASE_CONVERSION_COMPLETE(
+        details::binary_to_octal(details::hexadecimal_to_binary(str)));
 }
 
-inline auto hexadecimal_to_decimal(std::string_view str) -> std::string {
+EVQOVV_BASE_CONVERSION_DECL auto hexadecimal_to_decimal(std::string_view str)
+    -> std::string {
+    EVQOVV_BASE_CONVERSION_PROBE(hexadecimal_to_decimal, str);
+
     details::validate_string(str);
 
     uint64_t result{};
@@ -379,7 +392,65 @@ inline auto hexadecimal_to_decimal(std::string_view str) -> std::string {
         result = result * details::hexadecimal_base + digit;
     }
 
-    return std::to_string(result);
+    return EVQOVV_BASE_CONVERSION_COMPLETE(std::to_string(result));
+}
+
+EVQOVV_BASE_CONVERSION_DECL auto convert(base from, base to,
+                                         std::string_view str)
+    -> std::string {
+    switch (from) {
+    case base::binary:
+        switch (to) {
+        case base::binary:
+            break;
+        case base::octal:
+            return binary_to_octal(str);
+        case base::decimal:
+            return binary_to_decimal(str);
+        case base::hexadecimal:
+            return binary_to_hexadecimal(str);
+        }
+        break;
+    case base::octal:
+        switch (to) {
+        case base::octal:
+            break;
+        case base::binary:
+            return octal_to_binary(str);
+        case base::decimal:
+            return octal_to_decimal(str);
+        case base::hexadecimal:
+            return octal_to_hexadecimal(str);
+        }
+        break;
+    case base::decimal:
+        switch (to) {
+        case base::decimal:
+            break;
+        case base::binary:
+            return decimal_to_binary(str);
+        case base::octal:
+            return decimal_to_octal(str);
+        case base::hexadecimal:
+            return decimal_to_hexadecimal(str);
+        }
+        break;
+    case base::hexadecimal:
+        switch (to) {
+        case base::hexadecimal:
+            break;
+        case base::binary:
+            return hexadecimal_to_binary(str);
+        case base::octal:
+            return hexadecimal_to_octal(str);
+        case base::decimal:
+            return hexadecimal_to_decimal(str);
+        }
+        break;
+    }
+
+    return details::same_base(from, str);
 }
 } // namespace base_conversion
-} // namespace evqovv
\ No newline at end of file
+} // namespace evqovv
+#endif
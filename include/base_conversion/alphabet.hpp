@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "big_number.hpp"
+#include "buffer.hpp"
+#include "details.hpp"
+#include "validation.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+// A string literal usable as a template argument.
+template <std::size_t N>
+struct fixed_string {
+    constexpr fixed_string(char const (&str)[N]) noexcept {
+        std::copy_n(str, N, chars);
+    }
+
+    constexpr auto view() const noexcept -> std::string_view {
+        return {chars, N - 1};
+    }
+
+    char chars[N]{};
+};
+
+// The digits of a radix between 2 and 64, in order of value. With
+// `case_insensitive` a letter also matches its other case when that case is
+// not a digit of its own. `aliases` lists extra (character, digit) pairs
+// accepted when decoding, such as Crockford's "O0I1L1".
+template <fixed_string digits, bool case_insensitive = false,
+          fixed_string aliases = "">
+struct alphabet {
+    static constexpr std::string_view characters = digits.view();
+    static constexpr std::size_t radix = characters.size();
+
+    static_assert(radix >= 2 && radix <= 64);
+    static_assert(aliases.view().size() % 2 == 0);
+
+    // Value of every character, -1 if it is not a digit.
+    static constexpr auto values = [] {
+        std::array<signed char, 256> table{};
+        table.fill(-1);
+        for (std::size_t i{}; i != radix; ++i) {
+            table[static_cast<unsigned char>(characters[i])] =
+                static_cast<signed char>(i);
+        }
+
+        if constexpr (case_insensitive) {
+            for (std::size_t i{}; i != radix; ++i) {
+                auto const ch = characters[i];
+                auto const other = ch >= 'a' && ch <= 'z'   ? ch - 'a' + 'A'
+                                   : ch >= 'A' && ch <= 'Z' ? ch - 'A' + 'a'
+                                                            : ch;
+                if (table[static_cast<unsigned char>(other)] < 0) {
+                    table[static_cast<unsigned char>(other)] =
+                        static_cast<signed char>(i);
+                }
+            }
+        }
+
+        auto const extra = aliases.view();
+        for (std::size_t i{}; i != extra.size(); i += 2) {
+            table[static_cast<unsigned char>(extra[i])] =
+                table[static_cast<unsigned char>(extra[i + 1])];
+        }
+        return table;
+    }();
+
+    static_assert([] {
+        for (std::size_t i{}; i != radix; ++i) {
+            if (values[static_cast<unsigned char>(characters[i])] !=
+                static_cast<signed char>(i)) {
+                return false;
+            }
+        }
+        return true;
+    }(), "alphabet digits must be distinct");
+};
+
+using base36 = alphabet<"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ", true>;
+using base62 =
+    alphabet<"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz">;
+using crockford_base32 =
+    alphabet<"0123456789ABCDEFGHJKMNPQRSTVWXYZ", true, "O0o0I1i1L1l1">;
+
+namespace details {
+template <typename T>
+concept fixed_width_unsigned =
+    std::same_as<T, std::uint64_t> || std::same_as<T, uint128>;
+
+template <typename Alphabet>
+inline constexpr auto alphabet_limb_digits =
+    digits_per_limb(static_cast<limb>(Alphabet::radix));
+
+template <typename Alphabet>
+inline constexpr auto alphabet_limb_place = [] {
+    limb place = 1;
+    for (std::size_t i{}; i != alphabet_limb_digits<Alphabet>; ++i) {
+        place *= Alphabet::radix;
+    }
+    return place;
+}();
+
+// Writes the low `count` digits of `value` ending just before `end`.
+template <typename Alphabet>
+constexpr auto write_digits(std::uint64_t value, char *end,
+                            std::size_t count) noexcept -> void {
+    for (std::size_t i{}; i != count; ++i) {
+        *--end = Alphabet::characters[value % Alphabet::radix];
+        value /= Alphabet::radix;
+    }
+}
+} // namespace details
+
+// A 64- or 128-bit value in `Alphabet`, left-padded with the zero digit to
+// at least `width` characters. The radix is a constant here, so every
+// division compiles to a multiplication.
+template <typename Alphabet, details::fixed_width_unsigned T>
+auto encode(T value, std::size_t width = 0) -> std::string {
+    constexpr auto step = details::alphabet_limb_digits<Alphabet>;
+    constexpr auto place = details::alphabet_limb_place<Alphabet>;
+
+    // Up to three 64-bit groups cover any 128-bit value.
+    std::array<char, 3 * step> buffer;
+    auto *const end = buffer.data() + buffer.size();
+    auto *begin = end;
+    do {
+        auto const group = static_cast<std::uint64_t>(value % place);
+        value /= place;
+        details::write_digits<Alphabet>(group, begin, step);
+        begin -= step;
+    } while (value != 0);
+
+    while (end - begin > 1 && *begin == Alphabet::characters[0]) {
+        ++begin;
+    }
+    auto const size = static_cast<std::size_t>(end - begin);
+    std::string result(width > size ? width - size : 0,
+                       Alphabet::characters[0]);
+    result.append(begin, end);
+    return result;
+}
+
+// Parses `str` in `Alphabet` into a 64- or 128-bit value, throwing on
+// invalid characters and on overflow.
+template <typename Alphabet, details::fixed_width_unsigned T = std::uint64_t>
+auto decode(std::string_view str) -> T {
+    details::validate_string(str);
+
+    constexpr auto max = std::numeric_limits<T>::max();
+    T result{};
+    for (auto &&ch : str) {
+        auto const digit = Alphabet::values[static_cast<unsigned char>(ch)];
+        if (digit < 0) {
+            details::throw_invalid_character_error(ch);
+        }
+        if (result > (max - static_cast<T>(digit)) / Alphabet::radix) {
+            details::throw_overflow_error();
+        }
+        result = result * Alphabet::radix + static_cast<T>(digit);
+    }
+    return result;
+}
+
+// A number of any length written in `from` re-encoded with `Alphabet`.
+template <typename Alphabet>
+auto encode(base from, std::string_view str) -> std::string {
+    details::validate_string(str);
+
+    auto const &decimal_values =
+        details::digit_tables[static_cast<std::size_t>(base::decimal)];
+    auto value = from == base::decimal
+                     ? details::parse_digits(str, decimal_values,
+                                             details::decimal_base)
+                     : details::from_power_of_two_string(from, str);
+    return details::format_digits(std::move(value), Alphabet::characters);
+}
+
+// A number of any length written with `Alphabet`, converted to `to`.
+template <typename Alphabet>
+auto decode(std::string_view str, base to) -> std::string {
+    details::validate_string(str);
+
+    auto value = details::parse_digits(str, Alphabet::values, Alphabet::radix);
+    if (to == base::decimal) {
+        return details::to_decimal_string(std::move(value));
+    }
+    return details::to_power_of_two_string(value, to);
+}
+} // namespace base_conversion
+} // namespace evqovv
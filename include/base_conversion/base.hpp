@@ -0,0 +1,12 @@
+#pragma once
+
+namespace evqovv {
+namespace base_conversion {
+enum class base : unsigned char {
+    binary,
+    octal,
+    decimal,
+    hexadecimal,
+};
+} // namespace base_conversion
+} // namespace evqovv
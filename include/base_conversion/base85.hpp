@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "details.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+namespace details {
+inline constexpr std::string_view z85_characters =
+    "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    ".-:+=^!/*?&<>()[]{}@%$#";
+
+inline constexpr auto z85_values = [] {
+    std::array<signed char, 256> table{};
+    table.fill(-1);
+    for (std::size_t i{}; i != z85_characters.size(); ++i) {
+        table[static_cast<unsigned char>(z85_characters[i])] =
+            static_cast<signed char>(i);
+    }
+    return table;
+}();
+
+inline constexpr auto ascii85_values = [] {
+    std::array<signed char, 256> table{};
+    table.fill(-1);
+    for (std::size_t i{}; i != 85; ++i) {
+        table['!' + i] = static_cast<signed char>(i);
+    }
+    return table;
+}();
+
+inline auto load_group(std::uint8_t const *data) noexcept -> std::uint32_t {
+    return static_cast<std::uint32_t>(data[0]) << 24 |
+           static_cast<std::uint32_t>(data[1]) << 16 |
+           static_cast<std::uint32_t>(data[2]) << 8 |
+           static_cast<std::uint32_t>(data[3]);
+}
+
+inline auto store_group(std::uint32_t value, std::uint8_t *out) noexcept
+    -> void {
+    out[0] = static_cast<std::uint8_t>(value >> 24);
+    out[1] = static_cast<std::uint8_t>(value >> 16);
+    out[2] = static_cast<std::uint8_t>(value >> 8);
+    out[3] = static_cast<std::uint8_t>(value);
+}
+
+// Five digits of `value`, most significant first. Every divisor is a
+// constant, so each step is a multiplication by its reciprocal.
+inline auto encode_group(std::uint32_t value, char const *characters,
+                         char *out) noexcept -> void {
+    out[0] = characters[value / (85u * 85 * 85 * 85)];
+    out[1] = characters[value / (85u * 85 * 85) % 85];
+    out[2] = characters[value / (85u * 85) % 85];
+    out[3] = characters[value / 85 % 85];
+    out[4] = characters[value % 85];
+}
+
+// Returns false on a character outside the alphabet or a group above
+// 2^32 - 1; the digit lookups are OR-ed so that the check costs one branch.
+inline auto decode_group(char const *in,
+                         std::array<signed char, 256> const &values,
+                         std::uint32_t &value) noexcept -> bool {
+    auto const d0 = values[static_cast<unsigned char>(in[0])];
+    auto const d1 = values[static_cast<unsigned char>(in[1])];
+    auto const d2 = values[static_cast<unsigned char>(in[2])];
+    auto const d3 = values[static_cast<unsigned char>(in[3])];
+    auto const d4 = values[static_cast<unsigned char>(in[4])];
+    if ((d0 | d1 | d2 | d3 | d4) < 0) {
+        return false;
+    }
+
+    auto wide = static_cast<std::uint64_t>(d0);
+    wide = wide * 85 + static_cast<std::uint64_t>(d1);
+    wide = wide * 85 + static_cast<std::uint64_t>(d2);
+    wide = wide * 85 + static_cast<std::uint64_t>(d3);
+    wide = wide * 85 + static_cast<std::uint64_t>(d4);
+    value = static_cast<std::uint32_t>(wide);
+    return wide >> 32 == 0;
+}
+
+[[noreturn]] inline auto throw_base85_error(char const *what) -> void {
+    throw std::invalid_argument(std::string("base conversion error: ") +
+                                what);
+}
+
+// Reports the first offending character of a group that failed to decode.
+inline auto throw_group_error(char const *in, std::size_t size,
+                              std::array<signed char, 256> const &values)
+    -> void {
+    for (std::size_t i{}; i != size; ++i) {
+        if (values[static_cast<unsigned char>(in[i])] < 0) {
+            throw_invalid_character_error(in[i]);
+        }
+    }
+    throw_base85_error("base85 group exceeds 32 bits");
+}
+} // namespace details
+
+// ZeroMQ's Z85 (RFC 32). The input length must be a multiple of 4.
+inline auto encode_z85(std::span<std::uint8_t const> data) -> std::string {
+    if (data.size() % 4 != 0) {
+        details::throw_base85_error("Z85 input length is not a multiple of 4");
+    }
+
+    auto const size = data.size() / 4 * 5;
+    std::string result;
+    result.resize_and_overwrite(size, [&](char *out, std::size_t) {
+        for (std::size_t i{}; i != data.size(); i += 4, out += 5) {
+            details::encode_group(details::load_group(data.data() + i),
+                                  details::z85_characters.data(), out);
+        }
+        return size;
+    });
+    return result;
+}
+
+// The input length must be a multiple of 5.
+inline auto decode_z85(std::string_view str) -> std::vector<std::uint8_t> {
+    if (str.size() % 5 != 0) {
+        details::throw_base85_error("Z85 input length is not a multiple of 5");
+    }
+
+    std::vector<std::uint8_t> result(str.size() / 5 * 4);
+    auto *out = result.data();
+    for (std::size_t i{}; i != str.size(); i += 5, out += 4) {
+        std::uint32_t value{};
+        if (!details::decode_group(str.data() + i, details::z85_values,
+                                   value)) {
+            details::throw_group_error(str.data() + i, 5,
+                                       details::z85_values);
+        }
+        details::store_group(value, out);
+    }
+    return result;
+}
+
+// Adobe/btoa Ascii85 without the "<~" "~>" delimiters. Four zero bytes
+// become 'z' and a final partial group of n bytes takes n + 1 characters.
+inline auto encode_ascii85(std::span<std::uint8_t const> data)
+    -> std::string {
+    constexpr auto characters = [] {
+        std::array<char, 85> table{};
+        for (std::size_t i{}; i != table.size(); ++i) {
+            table[i] = static_cast<char>('!' + i);
+        }
+        return table;
+    }();
+
+    std::string result;
+    result.reserve((data.size() + 3) / 4 * 5);
+
+    std::size_t i{};
+    for (; i + 4 <= data.size(); i += 4) {
+        auto const value = details::load_group(data.data() + i);
+        if (value == 0) {
+            result += 'z';
+            continue;
+        }
+        char group[5];
+        details::encode_group(value, characters.data(), group);
+        result.append(group, 5);
+    }
+
+    if (auto const rest = data.size() - i; rest != 0) {
+        std::uint8_t padded[4]{};
+        std::copy_n(data.data() + i, rest, padded);
+        char group[5];
+        details::encode_group(details::load_group(padded), characters.data(),
+                              group);
+        result.append(group, rest + 1);
+    }
+    return result;
+}
+
+inline auto decode_ascii85(std::string_view str)
+    -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> result;
+    result.reserve(str.size() / 5 * 4 + 4);
+
+    std::size_t i{};
+    while (i != str.size()) {
+        if (str[i] == 'z') {
+            result.insert(result.end(), 4, 0);
+            ++i;
+            continue;
+        }
+
+        auto const rest = str.size() - i;
+        if (rest < 5) {
+            if (rest == 1) {
+                details::throw_base85_error("truncated Ascii85 group");
+            }
+            char padded[5] = {'u', 'u', 'u', 'u', 'u'};
+            std::copy_n(str.data() + i, rest, padded);
+            std::uint32_t value{};
+            if (!details::decode_group(padded, details::ascii85_values,
+                                       value)) {
+                details::throw_group_error(padded, 5,
+                                           details::ascii85_values);
+            }
+            std::uint8_t bytes[4];
+            details::store_group(value, bytes);
+            result.insert(result.end(), bytes, bytes + rest - 1);
+            break;
+        }
+
+        std::uint32_t value{};
+        if (!details::decode_group(str.data() + i, details::ascii85_values,
+                                   value)) {
+            details::throw_group_error(str.data() + i, 5,
+                                       details::ascii85_values);
+        }
+        auto const size = result.size();
+        result.resize(size + 4);
+        details::store_group(value, result.data() + size);
+        i += 5;
+    }
+    return result;
+}
+} // namespace base_conversion
+} // namespace evqovv
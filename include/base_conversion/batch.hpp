@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../base_conversion.hpp"
+#include "executor.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+struct batch_item {
+    base from;
+    base to;
+    std::string_view input;
+};
+
+enum class batch_status : unsigned char {
+    ok,
+    invalid_argument,
+    overflow,
+};
+
+// On failure `value` holds the error message instead of a result.
+struct batch_output {
+    batch_status status{};
+    std::string value;
+};
+
+inline auto convert_one(batch_item const &item, batch_output &output)
+    -> void {
+    try {
+        output.value = convert(item.from, item.to, item.input);
+        output.status = batch_status::ok;
+    } catch (std::overflow_error const &e) {
+        output.value = e.what();
+        output.status = batch_status::overflow;
+    } catch (std::invalid_argument const &e) {
+        output.value = e.what();
+        output.status = batch_status::invalid_argument;
+    }
+}
+
+// Converts every item independently; a failing item never affects the
+// others.
+inline auto convert_batch(std::span<batch_item const> items)
+    -> std::vector<batch_output> {
+    std::vector<batch_output> result(items.size());
+    for (decltype(items.size()) i{}; i != items.size(); ++i) {
+        convert_one(items[i], result[i]);
+    }
+    return result;
+}
+
+// convert_batch() with the items shared out among `executor`'s tasks in
+// contiguous runs. Results are in item order either way.
+template <executor Executor>
+auto convert_batch(Executor &executor, std::span<batch_item const> items)
+    -> std::vector<batch_output> {
+    std::vector<batch_output> result(items.size());
+    auto const task_count = std::min(executor.concurrency(), items.size());
+    executor.bulk_execute(task_count, [&](std::size_t task) {
+        auto const begin = items.size() * task / task_count;
+        auto const end = items.size() * (task + 1) / task_count;
+        for (auto i = begin; i != end; ++i) {
+            convert_one(items[i], result[i]);
+        }
+    });
+    return result;
+}
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,443 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "buffer.hpp"
+#include "details.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+namespace details {
+// Arbitrary-precision values are little-endian vectors of 64-bit limbs with
+// no zero limb on top; zero is the empty vector.
+using limb = std::uint64_t;
+
+inline constexpr std::size_t decimal_limb_digits = 19;
+
+inline constexpr auto powers_of_ten = [] {
+    std::array<limb, decimal_limb_digits + 1> table{};
+    table[0] = 1;
+    for (std::size_t i = 1; i != table.size(); ++i) {
+        table[i] = table[i - 1] * 10;
+    }
+    return table;
+}();
+
+inline auto trim_limbs(std::vector<limb> &value) noexcept -> void {
+    while (!value.empty() && value.back() == 0) {
+        value.pop_back();
+    }
+}
+
+// value = value * factor + addend
+inline auto multiply_add(std::vector<limb> &value, limb factor,
+                         limb addend) -> void {
+    auto carry = static_cast<uint128>(addend);
+    for (auto &l : value) {
+        auto const product = static_cast<uint128>(l) * factor + carry;
+        l = static_cast<limb>(product);
+        carry = product >> 64;
+    }
+    if (carry != 0) {
+        value.push_back(static_cast<limb>(carry));
+    }
+}
+
+// value = value / divisor, returning the remainder.
+inline auto divide_small(std::vector<limb> &value, limb divisor) noexcept
+    -> limb {
+    uint128 remainder{};
+    for (auto l = value.rbegin(); l != value.rend(); ++l) {
+        auto const current = (remainder << 64) | *l;
+        *l = static_cast<limb>(current / divisor);
+        remainder = current % divisor;
+    }
+    trim_limbs(value);
+    return static_cast<limb>(remainder);
+}
+
+inline auto compare(std::span<limb const> a, std::span<limb const> b) noexcept
+    -> int {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    for (auto i = a.size(); i-- != 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+inline auto multiply(std::span<limb const> a, std::span<limb const> b)
+    -> std::vector<limb> {
+    std::vector<limb> result(a.size() + b.size());
+    for (std::size_t i{}; i != a.size(); ++i) {
+        uint128 carry{};
+        for (std::size_t j{}; j != b.size(); ++j) {
+            auto const product =
+                static_cast<uint128>(a[i]) * b[j] + result[i + j] + carry;
+            result[i + j] = static_cast<limb>(product);
+            carry = product >> 64;
+        }
+        result[i + b.size()] = static_cast<limb>(carry);
+    }
+    trim_limbs(result);
+    return result;
+}
+
+// Quotient and remainder of u / v for non-zero v (Knuth, TAOCP 4.3.1 D).
+inline auto divide(std::span<limb const> u, std::span<limb const> v)
+    -> std::pair<std::vector<limb>, std::vector<limb>> {
+    if (compare(u, v) < 0) {
+        return {{}, {u.begin(), u.end()}};
+    }
+    if (v.size() == 1) {
+        std::vector<limb> quotient(u.begin(), u.end());
+        auto const remainder = divide_small(quotient, v[0]);
+        return {std::move(quotient),
+                remainder == 0 ? std::vector<limb>{}
+                               : std::vector<limb>{remainder}};
+    }
+
+    // Normalize so that the top limb of the divisor has its high bit set.
+    auto const n = v.size();
+    auto const m = u.size();
+    auto const shift = std::countl_zero(v.back());
+    auto const shifted = [&](std::span<limb const> x, std::size_t size) {
+        std::vector<limb> result(size);
+        for (std::size_t i{}; i != x.size(); ++i) {
+            result[i] |= x[i] << shift;
+            if (shift != 0 && i + 1 != size) {
+                result[i + 1] |= x[i] >> (64 - shift);
+            }
+        }
+        return result;
+    };
+    auto const vn = shifted(v, n);
+    auto un = shifted(u, m + 1);
+
+    std::vector<limb> quotient(m - n + 1);
+    for (auto j = m - n + 1; j-- != 0;) {
+        auto const top =
+            (static_cast<uint128>(un[j + n]) << 64) | un[j + n - 1];
+        auto qhat = top / vn[n - 1];
+        auto rhat = top % vn[n - 1];
+        while (qhat >> 64 != 0 ||
+               qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+            --qhat;
+            rhat += vn[n - 1];
+            if (rhat >> 64 != 0) {
+                break;
+            }
+        }
+
+        uint128 carry{};
+        limb borrow{};
+        for (std::size_t i{}; i != n; ++i) {
+            auto const product = qhat * vn[i] + carry;
+            carry = product >> 64;
+            auto const difference = static_cast<uint128>(un[i + j]) -
+                                    static_cast<limb>(product) - borrow;
+            un[i + j] = static_cast<limb>(difference);
+            borrow = difference >> 64 != 0;
+        }
+        auto const difference = static_cast<uint128>(un[j + n]) -
+                                static_cast<limb>(carry) - borrow;
+        un[j + n] = static_cast<limb>(difference);
+
+        if (difference >> 64 != 0) {
+            --qhat;
+            uint128 sum{};
+            for (std::size_t i{}; i != n; ++i) {
+                sum = static_cast<uint128>(un[i + j]) + vn[i] + (sum >> 64);
+                un[i + j] = static_cast<limb>(sum);
+            }
+            un[j + n] += static_cast<limb>(sum >> 64);
+        }
+        quotient[j] = static_cast<limb>(qhat);
+    }
+
+    std::vector<limb> remainder(n);
+    for (std::size_t i{}; i != n; ++i) {
+        remainder[i] = un[i] >> shift;
+        if (shift != 0) {
+            remainder[i] |= un[i + 1] << (64 - shift);
+        }
+    }
+    trim_limbs(quotient);
+    trim_limbs(remainder);
+    return {std::move(quotient), std::move(remainder)};
+}
+
+inline auto bit_width(std::span<limb const> value) noexcept -> std::size_t {
+    return value.empty() ? 0
+                         : (value.size() - 1) * 64 +
+                               static_cast<std::size_t>(
+                                   std::bit_width(value.back()));
+}
+
+// `count` (at most 8) bits of `value` starting at bit `pos`.
+inline auto extract_bits(std::span<limb const> value, std::size_t pos,
+                         std::size_t count) noexcept -> unsigned {
+    auto const index = pos / 64;
+    auto const shift = pos % 64;
+    auto bits = index < value.size() ? value[index] >> shift : 0;
+    if (shift + count > 64 && index + 1 < value.size()) {
+        bits |= value[index + 1] << (64 - shift);
+    }
+    return static_cast<unsigned>(bits & ((limb{1} << count) - 1));
+}
+
+inline auto from_power_of_two_string(base from, std::string_view digits)
+    -> std::vector<limb> {
+    auto const digit_bits = static_cast<std::size_t>(bits_per_digit(from));
+
+    std::vector<limb> value((digits.size() * digit_bits + 63) / 64);
+    std::size_t pos{};
+    for (auto ch = digits.rbegin(); ch != digits.rend();
+         ++ch, pos += digit_bits) {
+        auto const digit = digit_value(from, *ch);
+        if (digit < 0) {
+            throw_invalid_character_error(*ch);
+        }
+        auto const offset = pos % 64;
+        value[pos / 64] |= static_cast<limb>(digit) << offset;
+        if (offset + digit_bits > 64) {
+            value[pos / 64 + 1] |= static_cast<limb>(digit) >> (64 - offset);
+        }
+    }
+    trim_limbs(value);
+    return value;
+}
+
+// Binary, octal or hexadecimal digits of `value`, most significant first.
+inline auto to_power_of_two_string(std::span<limb const> value, base to)
+    -> std::string {
+    auto const digit_bits = static_cast<std::size_t>(bits_per_digit(to));
+    auto const size =
+        std::max<std::size_t>((bit_width(value) + digit_bits - 1) / digit_bits,
+                              1);
+
+    std::string result;
+    result.resize_and_overwrite(size, [&](char *out, std::size_t) {
+        for (auto pos = size * digit_bits; pos != 0; pos -= digit_bits) {
+            *out++ = decimal_to_hexadecimal_map(static_cast<int>(
+                extract_bits(value, pos - digit_bits, digit_bits)));
+        }
+        return size;
+    });
+    return result;
+}
+
+// Most digits of `radix` whose place value fits in one limb.
+inline constexpr auto digits_per_limb(limb radix) noexcept -> std::size_t {
+    std::size_t count{};
+    for (limb place = 1; place <= ~limb{} / radix; place *= radix) {
+        ++count;
+    }
+    return count;
+}
+
+// Digits of any radix up to 256, given the value of every character (-1
+// for characters outside the alphabet).
+inline auto parse_digits(std::string_view str,
+                         std::array<signed char, 256> const &table,
+                         limb radix) -> std::vector<limb> {
+    auto const step = digits_per_limb(radix);
+
+    std::vector<limb> value;
+    for (std::size_t pos{}; pos != str.size();) {
+        auto const count = std::min(step, str.size() - pos);
+        limb group{};
+        limb place = 1;
+        for (auto &&ch : str.substr(pos, count)) {
+            auto const digit = table[static_cast<unsigned char>(ch)];
+            if (digit < 0) {
+                throw_invalid_character_error(ch);
+            }
+            group = group * radix + static_cast<limb>(digit);
+            place *= radix;
+        }
+        multiply_add(value, place, group);
+        pos += count;
+    }
+    return value;
+}
+
+// `value` written with `alphabet`, whose size is the radix, most
+// significant digit first.
+inline auto format_digits(std::vector<limb> value, std::string_view alphabet)
+    -> std::string {
+    auto const radix = static_cast<limb>(alphabet.size());
+    auto const step = digits_per_limb(radix);
+    limb place = 1;
+    for (std::size_t i{}; i != step; ++i) {
+        place *= radix;
+    }
+
+    std::string result;
+    while (!value.empty()) {
+        auto group = divide_small(value, place);
+        for (std::size_t i{}; i != step; ++i) {
+            result += alphabet[group % radix];
+            group /= radix;
+        }
+    }
+    while (result.size() > 1 && result.back() == alphabet[0]) {
+        result.pop_back();
+    }
+    if (result.empty()) {
+        result += alphabet[0];
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+// Schoolbook: one pass of divide_small() per 19 output digits.
+inline auto to_decimal_string(std::vector<limb> value) -> std::string {
+    if (value.empty()) {
+        return "0";
+    }
+
+    std::vector<limb> groups;
+    while (!value.empty()) {
+        groups.push_back(divide_small(value, powers_of_ten.back()));
+    }
+
+    auto result = std::to_string(groups.back());
+    for (auto group = groups.rbegin() + 1; group != groups.rend(); ++group) {
+        auto const digits = std::to_string(*group);
+        result.append(decimal_limb_digits - digits.size(), '0');
+        result += digits;
+    }
+    return result;
+}
+
+// Values of at most this many limbs are converted by to_decimal_string().
+inline constexpr std::size_t decimal_leaf_limbs = 32;
+
+// Emits `value` in decimal, most significant chunk first, padded to
+// 19 * 2^(level + 1) digits when `pad` is set. powers[k] is 10^(19 * 2^k)
+// and value < powers[level + 1].
+template <typename Sink>
+auto emit_decimal(std::vector<limb> value, int level,
+                  std::span<std::vector<limb> const> powers, bool pad,
+                  Sink &sink) -> void {
+    if (level < 0 || value.size() <= decimal_leaf_limbs) {
+        auto digits = to_decimal_string(std::move(value));
+        if (pad) {
+            auto const width = decimal_limb_digits << (level + 1);
+            digits.insert(0, width - digits.size(), '0');
+        }
+        sink(std::string_view(digits));
+        return;
+    }
+
+    auto [high, low] = divide(value, powers[static_cast<std::size_t>(level)]);
+    value = {};
+    if (pad || !high.empty()) {
+        emit_decimal(std::move(high), level - 1, powers, pad, sink);
+        pad = true;
+    }
+    emit_decimal(std::move(low), level - 1, powers, pad, sink);
+}
+} // namespace details
+
+// Writes a binary, octal or hexadecimal number in decimal as a series of
+// chunks, most significant first, without building the whole result. The
+// value is split recursively by 10^(19 * 2^k), so each chunk reaches `sink`
+// as soon as its subtree is done; concatenated, the chunks equal
+// convert(from, base::decimal, str) for values of any size.
+template <std::invocable<std::string_view> Sink>
+auto convert_to_decimal(base from, std::string_view str, Sink &&sink)
+    -> void {
+    details::validate_string(str);
+    if (from == base::decimal) {
+        for (auto &&ch : str) {
+            if (details::digit_value(from, ch) < 0) {
+                details::throw_invalid_character_error(ch);
+            }
+        }
+        sink(details::trim_leading_zeros(str));
+        return;
+    }
+
+    auto value = details::from_power_of_two_string(from, str);
+
+    std::vector<std::vector<details::limb>> powers{
+        {details::powers_of_ten.back()}};
+    while (powers.back().size() <= value.size()) {
+        powers.push_back(details::multiply(powers.back(), powers.back()));
+    }
+
+    details::emit_decimal(std::move(value),
+                          static_cast<int>(powers.size()) - 2, powers, false,
+                          sink);
+}
+
+// Parses a decimal number delivered in pieces. Digits are folded into the
+// value 19 at a time, so memory follows the size of the value rather than
+// the length of the text, which is never kept.
+class decimal_parser {
+public:
+    // On an invalid character the parser is reset to empty, discarding the
+    // digits fed so far, and the error is thrown.
+    auto feed(std::string_view chunk) -> void {
+        if (!chunk.empty()) {
+            fed_ = true;
+        }
+
+        for (auto &&ch : chunk) {
+            auto const digit = static_cast<unsigned>(ch - '0');
+            if (digit > 9) {
+                *this = {};
+                details::throw_invalid_character_error(ch);
+            }
+
+            pending_ = pending_ * 10 + digit;
+            if (++pending_digits_ == details::decimal_limb_digits) {
+                details::multiply_add(limbs_, details::powers_of_ten.back(),
+                                      pending_);
+                pending_ = 0;
+                pending_digits_ = 0;
+            }
+        }
+    }
+
+    // The number in `to`, without leading zeros. The parser is then empty
+    // and can be reused.
+    auto finish(base to) -> std::string {
+        if (!fed_) {
+            details::validate_string({});
+        }
+
+        details::multiply_add(limbs_, details::powers_of_ten[pending_digits_],
+                              pending_);
+        auto value = std::move(limbs_);
+        *this = {};
+
+        if (to == base::decimal) {
+            return details::to_decimal_string(std::move(value));
+        }
+        return details::to_power_of_two_string(value, to);
+    }
+
+private:
+    std::vector<details::limb> limbs_;
+    details::limb pending_{};
+    std::size_t pending_digits_{};
+    bool fed_{};
+};
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+
+#include "../base_conversion.hpp"
+#include "details.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+enum class conversion_errc : unsigned char {
+    ok,
+    empty_string,
+    invalid_character,
+    overflow,
+    buffer_too_small,
+};
+
+// `size` is the number of characters written on success and the number
+// required when the buffer was too small.
+struct conversion_result {
+    conversion_errc ec{};
+    std::size_t size{};
+};
+
+namespace details {
+inline constexpr auto bits_per_digit(base radix) noexcept -> int {
+    switch (radix) {
+    case base::binary:
+        return 1;
+    case base::octal:
+        return 3;
+    case base::hexadecimal:
+        return 4;
+    case base::decimal:
+        break;
+    }
+    return 0;
+}
+
+inline constexpr auto radix_of(base radix) noexcept -> int {
+    switch (radix) {
+    case base::binary:
+        return binary_base;
+    case base::octal:
+        return octal_base;
+    case base::decimal:
+        return decimal_base;
+    case base::hexadecimal:
+        break;
+    }
+    return hexadecimal_base;
+}
+
+// Returns -1 for characters that are not digits of `radix`.
+inline constexpr auto digit_value(base radix, char ch) noexcept -> int {
+    int value = -1;
+    if (ch >= '0' && ch <= '9') {
+        value = ch - '0';
+    } else if (ch >= 'A' && ch <= 'F') {
+        value = ch - 'A' + 10;
+    } else if (ch >= 'a' && ch <= 'f') {
+        value = ch - 'a' + 10;
+    }
+    return value < radix_of(radix) ? value : -1;
+}
+
+inline auto parse_uint64(base radix, std::string_view digits,
+                         std::uint64_t &value) noexcept -> conversion_errc {
+    auto const multiplier = static_cast<std::uint64_t>(radix_of(radix));
+
+    value = 0;
+    for (auto &&ch : digits) {
+        auto const digit = static_cast<std::uint64_t>(digit_value(radix, ch));
+        if (value > (std::numeric_limits<std::uint64_t>::max() - digit) /
+                        multiplier) {
+            return conversion_errc::overflow;
+        }
+        value = value * multiplier + digit;
+    }
+    return conversion_errc::ok;
+}
+
+inline auto format_uint64(base radix, std::uint64_t value,
+                          std::span<char> out) noexcept -> conversion_result {
+    char digits[64];
+    auto const [end, ec] = std::to_chars(digits, digits + sizeof(digits),
+                                         value, radix_of(radix));
+    auto const size = static_cast<std::size_t>(end - digits);
+    if (size > out.size()) {
+        return {conversion_errc::buffer_too_small, size};
+    }
+
+    for (std::size_t i{}; i != size; ++i) {
+        out[i] = (digits[i] >= 'a') ? static_cast<char>(digits[i] - 'a' + 'A')
+                                    : digits[i];
+    }
+    return {conversion_errc::ok, size};
+}
+
+// Output size of regrouping `digits`, which are already validated and
+// stripped of leading zeros, from one power-of-two base into another.
+inline auto regrouped_size(base from, base to, std::string_view digits) noexcept
+    -> std::size_t {
+    auto const from_bits = static_cast<std::size_t>(bits_per_digit(from));
+    auto const to_bits = static_cast<std::size_t>(bits_per_digit(to));
+
+    auto const leading = static_cast<unsigned>(digit_value(from, digits[0]));
+    auto const significant_bits =
+        (digits.size() - 1) * from_bits +
+        static_cast<std::size_t>(std::bit_width(leading));
+    return std::max<std::size_t>(1, (significant_bits + to_bits - 1) / to_bits);
+}
+
+// Passes each of the regrouped_size() output digits to `put`, most
+// significant first.
+template <typename Put>
+inline auto regroup_each(base from, base to, std::string_view digits,
+                         std::size_t size, Put &&put) -> void {
+    auto const from_bits = static_cast<std::size_t>(bits_per_digit(from));
+    auto const to_bits = static_cast<std::size_t>(bits_per_digit(to));
+    auto const full_size = (digits.size() * from_bits + to_bits - 1) / to_bits;
+
+    regroup_digits(
+        digits, from_bits, to_bits, full_size - size,
+        [&](char ch) { return digit_value(from, ch); }, put,
+        [&](std::size_t count) {
+            for (std::size_t k{}; k != count; ++k) {
+                put('0');
+            }
+        });
+}
+
+// Power-of-two to power-of-two regrouping into a caller buffer; `digits`
+// is already validated and stripped of leading zeros.
+inline auto regroup(base from, base to, std::string_view digits,
+                    std::span<char> out) noexcept -> conversion_result {
+    auto const size = regrouped_size(from, to, digits);
+    if (size > out.size()) {
+        return {conversion_errc::buffer_too_small, size};
+    }
+
+    std::size_t pos{};
+    regroup_each(from, to, digits, size, [&](char ch) { out[pos++] = ch; });
+    return {conversion_errc::ok, size};
+}
+} // namespace details
+
+// An upper bound on the output size of convert_into() for any input of
+// `input_size` characters.
+inline constexpr auto max_output_size(base from, base to,
+                                      std::size_t input_size) noexcept
+    -> std::size_t {
+    if (from == base::decimal || to == base::decimal) {
+        return 64;
+    }
+
+    auto const from_bits =
+        static_cast<std::size_t>(details::bits_per_digit(from));
+    auto const to_bits = static_cast<std::size_t>(details::bits_per_digit(to));
+    return std::max<std::size_t>(
+        1, (input_size * from_bits + to_bits - 1) / to_bits);
+}
+
+// Non-throwing, non-allocating counterpart of convert() that writes into a
+// caller-provided buffer. Results match convert(), except that the whole
+// input is validated before any value is accumulated: decimal input no longer
+// stops at the first non-digit, and an invalid character is reported even
+// when an overflow would have been hit first.
+inline auto convert_into(base from, base to, std::string_view str,
+                         std::span<char> out) noexcept -> conversion_result {
+    if (str.empty()) {
+        return {conversion_errc::empty_string, 0};
+    }
+    for (auto &&ch : str) {
+        if (details::digit_value(from, ch) < 0) {
+            return {conversion_errc::invalid_character, 0};
+        }
+    }
+
+    auto const first_non_zero = str.find_first_not_of('0');
+    auto const digits = first_non_zero == std::string_view::npos
+                            ? std::string_view("0")
+                            : str.substr(first_non_zero);
+
+    if (from == base::decimal || to == base::decimal) {
+        std::uint64_t value{};
+        if (auto const ec = details::parse_uint64(from, digits, value);
+            ec != conversion_errc::ok) {
+            return {ec, 0};
+        }
+        return details::format_uint64(to, value, out);
+    }
+
+    if (from == to) {
+        if (digits.size() > out.size()) {
+            return {conversion_errc::buffer_too_small, digits.size()};
+        }
+        // Uppercase, like the output of every other conversion.
+        std::transform(digits.begin(), digits.end(), out.begin(), [&](char ch) {
+            return details::decimal_to_hexadecimal_map(
+                details::digit_value(from, ch));
+        });
+        return {conversion_errc::ok, digits.size()};
+    }
+
+    return details::regroup(from, to, digits, out);
+}
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../base_conversion.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+struct cache_options {
+    std::size_t shard_count = 16;
+    std::size_t slots_per_shard = 1024;
+    // Each slot owns this many arena bytes for key and value together;
+    // conversions that do not fit are passed through uncached.
+    std::size_t slot_bytes = 96;
+    // A (from, to) pair whose hit rate over `window` lookups falls below
+    // `min_hit_rate` bypasses the cache for the next `cooldown` calls.
+    double min_hit_rate = 0.25;
+    std::size_t window = 4096;
+    std::size_t cooldown = 1 << 18;
+};
+
+struct cache_stats {
+    std::uint64_t hits{};
+    std::uint64_t misses{};
+    std::uint64_t evictions{};
+    std::uint64_t uncacheable{};
+    std::uint64_t bypassed{};
+    std::size_t disabled_pairs{};
+
+    auto hit_rate() const noexcept -> double {
+        auto const lookups = hits + misses;
+        return lookups == 0 ? 0
+                            : static_cast<double>(hits) /
+                                  static_cast<double>(lookups);
+    }
+};
+
+namespace details {
+inline constexpr std::size_t base_count = 4;
+
+struct cache_slot {
+    std::uint64_t hash{};
+    std::uint32_t key_size{};
+    std::uint32_t value_size{};
+    base from{};
+    base to{};
+    bool used{};
+    bool referenced{};
+};
+
+class cache_shard {
+public:
+    cache_shard(std::size_t slot_count, std::size_t slot_bytes)
+        : slot_bytes_(slot_bytes), slots_(slot_count),
+          arena_(slot_count * slot_bytes) {
+        index_.reserve(slot_count);
+    }
+
+    auto find(std::uint64_t hash, base from, base to, std::string_view key,
+              std::string &value) -> bool {
+        std::lock_guard lock(mutex_);
+
+        auto const it = index_.find(hash);
+        if (it == index_.end()) {
+            return false;
+        }
+
+        auto &slot = slots_[it->second];
+        auto const *data = arena_.data() + it->second * slot_bytes_;
+        if (slot.from != from || slot.to != to || slot.key_size != key.size() ||
+            std::memcmp(data, key.data(), key.size()) != 0) {
+            return false;
+        }
+
+        slot.referenced = true;
+        value.assign(data + slot.key_size, slot.value_size);
+        return true;
+    }
+
+    // Returns true when an older entry had to be evicted.
+    auto insert(std::uint64_t hash, base from, base to, std::string_view key,
+                std::string_view value) -> bool {
+        std::lock_guard lock(mutex_);
+
+        auto evicted = false;
+        std::size_t victim{};
+        if (auto const it = index_.find(hash); it != index_.end()) {
+            victim = it->second;
+        } else {
+            victim = next_victim();
+            if (slots_[victim].used) {
+                index_.erase(slots_[victim].hash);
+                evicted = true;
+            }
+            index_.emplace(hash, victim);
+        }
+
+        auto *data = arena_.data() + victim * slot_bytes_;
+        std::memcpy(data, key.data(), key.size());
+        std::memcpy(data + key.size(), value.data(), value.size());
+        slots_[victim] = {hash,
+                          static_cast<std::uint32_t>(key.size()),
+                          static_cast<std::uint32_t>(value.size()),
+                          from,
+                          to,
+                          true,
+                          false};
+        return evicted;
+    }
+
+private:
+    // CLOCK: sweep the hand, giving referenced slots a second chance.
+    auto next_victim() noexcept -> std::size_t {
+        while (true) {
+            auto &slot = slots_[hand_];
+            auto const current = hand_;
+            hand_ = (hand_ + 1) % slots_.size();
+            if (!slot.used || !slot.referenced) {
+                return current;
+            }
+            slot.referenced = false;
+        }
+    }
+
+    std::mutex mutex_;
+    std::size_t slot_bytes_;
+    std::vector<cache_slot> slots_;
+    std::vector<char> arena_;
+    std::unordered_map<std::uint64_t, std::size_t> index_;
+    std::size_t hand_{};
+};
+
+struct cache_pair_state {
+    std::atomic<std::uint64_t> window_lookups{};
+    std::atomic<std::uint64_t> window_hits{};
+    std::atomic<std::uint64_t> bypass_remaining{};
+};
+} // namespace details
+
+// Sharded memoizing front for convert(). Memory is bounded by
+// shard_count * slots_per_shard * slot_bytes plus per-slot bookkeeping.
+class conversion_cache {
+public:
+    explicit conversion_cache(cache_options const &options = {})
+        : options_(options) {
+        if (options_.shard_count == 0 || options_.slots_per_shard == 0 ||
+            options_.slot_bytes == 0) {
+            throw std::invalid_argument(
+                "base conversion error: cache dimensions must be non-zero");
+        }
+
+        shards_.reserve(options_.shard_count);
+        for (std::size_t i{}; i != options_.shard_count; ++i) {
+            shards_.push_back(std::make_unique<details::cache_shard>(
+                options_.slots_per_shard, options_.slot_bytes));
+        }
+    }
+
+    auto convert(base from, base to, std::string_view str) -> std::string {
+        auto &pair = pairs_[static_cast<std::size_t>(from) *
+                                details::base_count +
+                            static_cast<std::size_t>(to)];
+
+        auto remaining = pair.bypass_remaining.load(std::memory_order_relaxed);
+        if (remaining != 0 &&
+            pair.bypass_remaining.compare_exchange_weak(
+                remaining, remaining - 1, std::memory_order_relaxed)) {
+            bypassed_.fetch_add(1, std::memory_order_relaxed);
+            return base_conversion::convert(from, to, str);
+        }
+
+        auto const hash = hash_of(from, to, str);
+        auto &shard = *shards_[(hash >> 32) % shards_.size()];
+
+        std::string result;
+        if (shard.find(hash, from, to, str, result)) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            account(pair, true);
+            return result;
+        }
+
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        account(pair, false);
+
+        result = base_conversion::convert(from, to, str);
+        if (str.size() + result.size() > options_.slot_bytes) {
+            uncacheable_.fetch_add(1, std::memory_order_relaxed);
+        } else if (shard.insert(hash, from, to, str, result)) {
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    auto stats() const noexcept -> cache_stats {
+        cache_stats result;
+        result.hits = hits_.load(std::memory_order_relaxed);
+        result.misses = misses_.load(std::memory_order_relaxed);
+        result.evictions = evictions_.load(std::memory_order_relaxed);
+        result.uncacheable = uncacheable_.load(std::memory_order_relaxed);
+        result.bypassed = bypassed_.load(std::memory_order_relaxed);
+        for (auto const &pair : pairs_) {
+            if (pair.bypass_remaining.load(std::memory_order_relaxed) != 0) {
+                ++result.disabled_pairs;
+            }
+        }
+        return result;
+    }
+
+private:
+    static auto hash_of(base from, base to, std::string_view str) noexcept
+        -> std::uint64_t {
+        auto const hash = std::hash<std::string_view>{}(str);
+        return static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15u ^
+               (static_cast<std::uint64_t>(from) << 2 |
+                static_cast<std::uint64_t>(to));
+    }
+
+    auto account(details::cache_pair_state &pair, bool hit) noexcept -> void {
+        auto const hits =
+            pair.window_hits.fetch_add(hit ? 1 : 0, std::memory_order_relaxed) +
+            (hit ? 1 : 0);
+        auto const lookups =
+            pair.window_lookups.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (lookups < options_.window) {
+            return;
+        }
+
+        pair.window_lookups.store(0, std::memory_order_relaxed);
+        pair.window_hits.store(0, std::memory_order_relaxed);
+        if (static_cast<double>(hits) <
+            options_.min_hit_rate * static_cast<double>(lookups)) {
+            pair.bypass_remaining.store(options_.cooldown,
+                                        std::memory_order_relaxed);
+        }
+    }
+
+    cache_options options_;
+    std::vector<std::unique_ptr<details::cache_shard>> shards_;
+    std::array<details::cache_pair_state,
+               details::base_count * details::base_count>
+        pairs_{};
+    std::atomic<std::uint64_t> hits_{};
+    std::atomic<std::uint64_t> misses_{};
+    std::atomic<std::uint64_t> evictions_{};
+    std::atomic<std::uint64_t> uncacheable_{};
+    std::atomic<std::uint64_t> bypassed_{};
+};
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "../base_conversion.hpp"
+#include "details.hpp"
+#include "parallel.hpp"
+#include "tuning.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+namespace tuning {
+namespace details {
+// One dispatcher decision: `below` runs for inputs shorter than the
+// threshold stored in `field`, `above` for everything else.
+struct crossover {
+    std::string_view name;
+    std::size_t thresholds::*field;
+    std::string_view alphabet;
+    std::size_t max_length;
+    auto (*below)(std::string_view) -> std::string;
+    auto (*above)(std::string_view) -> std::string;
+};
+
+inline auto crossovers() -> std::array<crossover, 2> const & {
+    static std::array<crossover, 2> const table{{
+        {"direct_transcode_min_length",
+         &thresholds::direct_transcode_min_length, "0123456789abcdef",
+         std::size_t{1} << 16,
+         [](std::string_view str) {
+             return binary_to_octal(hexadecimal_to_binary(str));
+         },
+         [](std::string_view str) {
+             return base_conversion::details::transcode<4, 3>(
+                 str, base_conversion::details::validate_hexadecimal_character,
+                 base_conversion::details::hexadecimal_to_decimal_map);
+         }},
+        {"parallel_min_length", &thresholds::parallel_min_length,
+         "0123456789abcdef", std::size_t{1} << 24,
+         [](std::string_view str) {
+             return base_conversion::convert(base::hexadecimal, base::binary,
+                                             str);
+         },
+         [](std::string_view str) {
+             return base_conversion::details::transcode_parallel(
+                 default_executor(), base::hexadecimal, base::binary, str, {},
+                 {});
+         }},
+    }};
+    return table;
+}
+
+// Deterministic pseudo-random input whose first digit is never '0', so the
+// measured length is the length actually converted.
+inline auto make_input(std::string_view alphabet, std::size_t length)
+    -> std::string {
+    std::string result(length, '0');
+    std::uint64_t state = 0x9e3779b97f4a7c15u ^ length;
+    for (auto &ch : result) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        ch = alphabet[1 + (state >> 33) % (alphabet.size() - 1)];
+    }
+    return result;
+}
+
+inline auto time_per_call(auto (*convert)(std::string_view)->std::string,
+                          std::string_view input,
+                          std::chrono::nanoseconds slice) -> double {
+    using clock = std::chrono::steady_clock;
+
+    std::size_t calls{};
+    std::size_t volatile sink{};
+    auto const start = clock::now();
+    auto now = start;
+    do {
+        sink = sink + convert(input).size();
+        ++calls;
+        if ((calls & 7) == 0) {
+            now = clock::now();
+        }
+    } while ((calls & 7) != 0 || now - start < slice);
+
+    return std::chrono::duration<double>(now - start).count() /
+           static_cast<double>(calls);
+}
+
+// Returns the smallest measured length from which `above` keeps winning, or
+// the current default when the budget runs out before the sweep completes.
+inline auto find_crossover(crossover const &entry, std::size_t fallback,
+                           std::chrono::nanoseconds budget) -> std::size_t {
+    auto const steps =
+        static_cast<std::size_t>(std::bit_width(entry.max_length));
+    auto const slice = budget / (2 * steps);
+    auto const deadline = std::chrono::steady_clock::now() + budget;
+
+    std::array<bool, std::numeric_limits<std::size_t>::digits> above_wins{};
+    for (std::size_t step{}; step != steps; ++step) {
+        auto const input =
+            make_input(entry.alphabet, std::size_t{1} << step);
+        auto const below = time_per_call(entry.below, input, slice);
+        auto const above = time_per_call(entry.above, input, slice);
+        above_wins[step] = above < below;
+
+        if (std::chrono::steady_clock::now() > deadline + slice) {
+            return fallback;
+        }
+    }
+
+    auto threshold = entry.max_length << 1;
+    for (auto step = steps; step != 0 && above_wins[step - 1]; --step) {
+        threshold = std::size_t{1} << (step - 1);
+    }
+    return threshold;
+}
+} // namespace details
+
+// Micro-benchmarks every dispatcher crossover within roughly `budget` and
+// returns the measured thresholds. Entries that cannot finish in their share
+// of the budget keep their default value.
+inline auto calibrate(std::chrono::nanoseconds budget =
+                          std::chrono::milliseconds(200)) -> thresholds {
+    auto const &table = details::crossovers();
+    auto const share = budget / table.size();
+
+    thresholds result;
+    for (auto const &entry : table) {
+        result.*entry.field =
+            details::find_crossover(entry, result.*entry.field, share);
+    }
+    return result;
+}
+
+inline auto calibrate_and_apply(std::chrono::nanoseconds budget =
+                                    std::chrono::milliseconds(200))
+    -> thresholds {
+    auto const result = calibrate(budget);
+    apply(result);
+    return result;
+}
+
+// Profiles are plain "name=value" lines; unknown names are ignored and
+// missing ones keep their defaults.
+inline auto save_profile(std::string const &path, thresholds const &values)
+    -> void {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error(std::format(
+            "base conversion error: cannot write profile '{}'", path));
+    }
+
+    for (auto const &entry : details::crossovers()) {
+        file << entry.name << '=' << values.*entry.field << '\n';
+    }
+}
+
+inline auto load_profile(std::string const &path) -> thresholds {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error(std::format(
+            "base conversion error: cannot read profile '{}'", path));
+    }
+
+    thresholds result;
+    std::string line;
+    while (std::getline(file, line)) {
+        // Profiles edited on Windows end their lines with CRLF.
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        auto const separator = line.find('=');
+        if (separator == std::string::npos) {
+            continue;
+        }
+
+        auto const name = std::string_view(line).substr(0, separator);
+        auto const value = std::string_view(line).substr(separator + 1);
+        for (auto const &entry : details::crossovers()) {
+            if (entry.name != name) {
+                continue;
+            }
+
+            std::size_t parsed{};
+            auto const *end = value.data() + value.size();
+            auto const [ptr, ec] = std::from_chars(value.data(), end, parsed);
+            if (ec != std::errc{} || ptr != end) {
+                throw std::runtime_error(std::format(
+                    "base conversion error: invalid value '{}' for {} in "
+                    "profile '{}'",
+                    value, name, path));
+            }
+            result.*entry.field = parsed;
+        }
+    }
+    return result;
+}
+} // namespace tuning
+} // namespace base_conversion
+} // namespace evqovv
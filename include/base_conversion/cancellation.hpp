@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "../base_conversion.hpp"
+#include "buffer.hpp"
+#include "details.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+class conversion_cancelled : public std::runtime_error {
+public:
+    conversion_cancelled()
+        : std::runtime_error("base conversion error: conversion cancelled") {}
+};
+
+// Called with the number of input characters consumed so far and the total.
+using progress_callback = std::function<void(std::size_t, std::size_t)>;
+
+namespace details {
+// Input characters handled between two stop checks; large enough that the
+// check and the callback do not show up next to the regrouping loop.
+inline constexpr std::size_t cancellation_chunk_size = 64 * 1024;
+
+class checkpoint {
+public:
+    checkpoint(std::stop_token token, progress_callback const &progress,
+               std::size_t total)
+        : token_(std::move(token)), progress_(progress), total_(total) {}
+
+    auto operator()(std::size_t processed) const -> void {
+        if (token_.stop_requested()) {
+            throw conversion_cancelled();
+        }
+        report(processed);
+    }
+
+    // Progress only, for when the work is already done.
+    auto report(std::size_t processed) const -> void {
+        if (progress_) {
+            progress_(processed, total_);
+        }
+    }
+
+private:
+    std::stop_token token_;
+    progress_callback const &progress_;
+    std::size_t total_;
+};
+
+// regroup_each() over chunks of whole output groups, counted from the least
+// significant digit, with a checkpoint before each chunk.
+inline auto transcode_cancellable(base from, base to, std::string_view str,
+                                  checkpoint const &check) -> std::string {
+    auto const digits = details::trim_leading_zeros(str);
+    auto const leading_zeros = str.size() - digits.size();
+    if (details::digit_value(from, digits[0]) < 0) {
+        details::throw_invalid_character_error(digits[0]);
+    }
+
+    auto const from_bits = static_cast<std::size_t>(bits_per_digit(from));
+    auto const to_bits = static_cast<std::size_t>(bits_per_digit(to));
+    auto const group_digits = std::lcm(from_bits, to_bits) / from_bits;
+    auto const chunk_digits = (cancellation_chunk_size + group_digits - 1) /
+                              group_digits * group_digits;
+
+    auto const n = digits.size();
+    auto const size = details::regrouped_size(from, to, digits);
+    auto const skip = (n * from_bits + to_bits - 1) / to_bits - size;
+
+    std::exception_ptr failure;
+    std::string result;
+    result.resize_and_overwrite(size, [&](char *out, std::size_t) {
+        try {
+            auto first = std::size_t{};
+            auto last = (n - 1) % chunk_digits + 1;
+            for (; first != n; first = last, last += chunk_digits) {
+                check(leading_zeros + first);
+
+                auto const input = digits.substr(first, last - first);
+                for (auto &&ch : input) {
+                    if (details::digit_value(from, ch) < 0) {
+                        details::throw_invalid_character_error(ch);
+                    }
+                }
+                auto const chunk_size =
+                    (input.size() * from_bits + to_bits - 1) / to_bits -
+                    (first == 0 ? skip : 0);
+                details::regroup_each(from, to, input, chunk_size,
+                                      [&](char ch) { *out++ = ch; });
+            }
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        return size;
+    });
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    check.report(str.size());
+    return result;
+}
+
+inline auto validate_cancellable(base radix, std::string_view str,
+                                 checkpoint const &check) -> void {
+    for (std::size_t offset{}; offset < str.size();
+         offset += cancellation_chunk_size) {
+        check(offset);
+        for (auto &&ch : str.substr(offset, cancellation_chunk_size)) {
+            if (details::digit_value(radix, ch) < 0) {
+                details::throw_invalid_character_error(ch);
+            }
+        }
+    }
+    check.report(str.size());
+}
+} // namespace details
+
+// convert() that checks `token` and reports progress every
+// details::cancellation_chunk_size input characters, throwing
+// conversion_cancelled once a stop has been requested. Conversions to or from
+// decimal are bounded by uint64_t and are only checked before they start.
+inline auto convert(base from, base to, std::string_view str,
+                    std::stop_token token,
+                    progress_callback const &progress = {}) -> std::string {
+    details::checkpoint const check(std::move(token), progress, str.size());
+
+    if (from == base::decimal || to == base::decimal) {
+        check(0);
+        auto result = base_conversion::convert(from, to, str);
+        check.report(str.size());
+        return result;
+    }
+
+    details::validate_string(str);
+
+    if (from == to) {
+        details::validate_cancellable(from, str, check);
+        return base_conversion::convert(from, to, str);
+    }
+    return details::transcode_cancellable(from, to, str, check);
+}
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,415 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <array>
+#include <charconv>
+#include <utility>
+#include <format>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "base.hpp"
+#include "tuning.hpp"
+
+#if defined(EVQOVV_BASE_CONVERSION_ENABLE_METRICS) ||                         \
+    defined(EVQOVV_BASE_CONVERSION_ENABLE_USDT)
+#include "probe.hpp"
+
+#define EVQOVV_BASE_CONVERSION_PROBE(function, input)                          \
+    ::evqovv::base_conversion::instrumentation::details::probe                 \
+        evqovv_base_conversion_probe_(                                         \
+            ::evqovv::base_conversion::instrumentation::function_id::function, \
+            (input).size())
+#define EVQOVV_BASE_CONVERSION_COMPLETE(...)                                   \
+    evqovv_base_conversion_probe_.complete(__VA_ARGS__)
+#define EVQOVV_BASE_CONVERSION_ERROR(kind)                                     \
+    ::evqovv::base_conversion::instrumentation::details::record_error(         \
+        ::evqovv::base_conversion::instrumentation::error_kind::kind)
+#else
+#define EVQOVV_BASE_CONVERSION_PROBE(function, input)
+#define EVQOVV_BASE_CONVERSION_COMPLETE(...) __VA_ARGS__
+#define EVQOVV_BASE_CONVERSION_ERROR(kind)
+#endif
+
+namespace evqovv {
+namespace base_conversion {
+namespace details {
+
+inline constexpr auto binary_base = 2;
+inline constexpr auto octal_base = 8;
+inline constexpr auto decimal_base = 10;
+inline constexpr auto hexadecimal_base = 16;
+
+// 128-bit arithmetic for the wide multiplications and fixed-width values;
+// GCC and Clang provide it on every 64-bit target.
+#ifdef __SIZEOF_INT128__
+__extension__ using uint128 = unsigned __int128;
+#else
+#error "evqovv::base_conversion requires a compiler with unsigned __int128"
+#endif
+
+template <bool uppercase = true>
+inline constexpr auto decimal_to_hexadecimal_map(int digit) noexcept -> char {
+    static constexpr std::array<char, 16> upper_chars{
+        '0', '1', '2', '3', '4', '5', '6', '7',
+        '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+    static constexpr std::array<char, 16> lower_chars{
+        '0', '1', '2', '3', '4', '5', '6', '7',
+        '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+
+    return uppercase ? upper_chars[digit] : lower_chars[digit];
+}
+
+// Value of every character as a hexadecimal digit, -1 for anything else.
+inline constexpr auto hexadecimal_values = [] {
+    std::array<signed char, 256> table{};
+    for (auto ch = 0; ch != 256; ++ch) {
+        table[ch] = ch >= '0' && ch <= '9'   ? ch - '0'
+                    : ch >= 'A' && ch <= 'F' ? ch - 'A' + 10
+                    : ch >= 'a' && ch <= 'f' ? ch - 'a' + 10
+                                             : -1;
+    }
+    return table;
+}();
+
+// The binary digits of 0-15, four characters each.
+inline constexpr auto binary_nibbles = [] {
+    std::array<std::array<char, 4>, 16> table{};
+    for (auto value = 0; value != 16; ++value) {
+        for (auto bit = 0; bit != 4; ++bit) {
+            table[value][bit] = ((value >> (3 - bit)) & 1) ? '1' : '0';
+        }
+    }
+    return table;
+}();
+
+// The binary digits of 0-255, eight characters each.
+inline constexpr auto binary_bytes = [] {
+    std::array<std::array<char, 8>, 256> table{};
+    for (auto value = 0; value != 256; ++value) {
+        for (auto bit = 0; bit != 8; ++bit) {
+            table[value][bit] = ((value >> (7 - bit)) & 1) ? '1' : '0';
+        }
+    }
+    return table;
+}();
+
+// The two uppercase hexadecimal digits of 0-255.
+inline constexpr auto hexadecimal_pairs = [] {
+    std::array<std::array<char, 2>, 256> table{};
+    for (auto value = 0; value != 256; ++value) {
+        table[value][0] = decimal_to_hexadecimal_map(value >> 4);
+        table[value][1] = decimal_to_hexadecimal_map(value & 15);
+    }
+    return table;
+}();
+
+inline constexpr auto hexadecimal_to_binary_map(int digit) noexcept
+    -> std::string_view {
+    auto const &group = binary_nibbles[static_cast<std::size_t>(
+        hexadecimal_values[static_cast<unsigned char>(digit)])];
+    return std::string_view(group.data(), group.size());
+}
+
+inline constexpr auto hexadecimal_to_decimal_map(int digit) noexcept -> int {
+    if (digit <= '9') {
+        return digit - '0';
+    } else if (digit <= 'F') {
+        return digit - 'A' + 10;
+    } else {
+        return digit - 'a' + 10;
+    }
+}
+
+inline constexpr auto octal_to_binary_map(int digit) noexcept
+    -> std::string_view {
+    return std::string_view(binary_nibbles[digit - '0'].data() + 1, 3);
+}
+
+// Packs up to eight '0'/'1' characters into an integer, first character
+// most significant.
+inline constexpr auto pack_binary(char const *data, std::size_t count) noexcept
+    -> unsigned {
+    unsigned value{};
+    for (std::size_t i{}; i != count; ++i) {
+        value = (value << 1) | (static_cast<unsigned>(data[i]) & 1);
+    }
+    return value;
+}
+
+// pack_binary(data, 8) with one load and one multiply.
+inline auto pack_binary_byte(char const *data) noexcept -> unsigned {
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) {
+        word = std::byteswap(word);
+    }
+    return static_cast<unsigned>(
+        ((word & 0x0101010101010101u) * 0x8040201008040201u) >> 56);
+}
+
+inline constexpr auto binary_to_hexadecimal_map(std::string_view str) -> char {
+    return decimal_to_hexadecimal_map(
+        static_cast<int>(pack_binary(str.data(), 4)));
+}
+
+inline constexpr auto binary_to_octal_map(std::string_view str) -> char {
+    return static_cast<char>('0' + pack_binary(str.data(), 3));
+}
+
+inline auto throw_invalid_character_error(char invalid_char) -> void {
+    EVQOVV_BASE_CONVERSION_ERROR(invalid_character);
+    throw std::invalid_argument(
+        std::format("base conversion error: invalid character '{}' in string",
+                    invalid_char));
+}
+
+inline auto throw_overflow_error() -> void {
+    EVQOVV_BASE_CONVERSION_ERROR(overflow);
+    throw std::overflow_error("base conversion error: the value represented by "
+                              "string exceeds uint64_t limit");
+}
+
+inline auto validate_string(std::string_view str) -> void {
+    if (str.empty()) [[unlikely]] {
+        EVQOVV_BASE_CONVERSION_ERROR(empty_string);
+        throw std::invalid_argument("base conversion error: string is empty");
+    }
+}
+
+inline auto validate_binary_character(char ch) -> void {
+    if ((ch & 0xfe) != '0') {
+        details::throw_invalid_character_error(ch);
+    }
+}
+
+inline auto validate_octal_character(char ch) -> void {
+    if ((ch & 0xf8) != '0') {
+        details::throw_invalid_character_error(ch);
+    }
+}
+
+inline auto validate_hexadecimal_character(char ch) -> void {
+    if (hexadecimal_values[static_cast<unsigned char>(ch)] < 0) {
+        details::throw_invalid_character_error(ch);
+    }
+}
+
+inline auto trim_leading_zeros(std::string_view str) noexcept
+    -> std::string_view {
+    validate_string(str);
+
+    auto const first_non_zero_pos = str.find_first_not_of('0');
+    return (first_non_zero_pos == std::string_view::npos)
+               ? "0"
+               : str.substr(first_non_zero_pos);
+}
+
+inline auto to_uint64_t(std::string_view str) -> uint64_t {
+    uint64_t result{};
+
+    auto [ptr, ec] =
+        std::from_chars(str.data(), str.data() + str.size(), result);
+    if (ec == std::errc::invalid_argument) {
+        details::throw_invalid_character_error(*ptr);
+    }
+    if (ec == std::errc::result_out_of_range) {
+        details::throw_overflow_error();
+    }
+
+    return result;
+}
+
+inline auto load_word(char const *data) noexcept -> std::uint64_t {
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+inline constexpr std::uint64_t zero_digits = 0x3030303030303030u;
+
+// Number of '0' characters at the start of [data, data + size), compared a
+// 32-byte block at a time.
+inline auto zero_run_length(char const *data, std::size_t size) noexcept
+    -> std::size_t {
+    std::size_t i{};
+    for (; i + 32 <= size; i += 32) {
+        if (((load_word(data + i) ^ zero_digits) |
+             (load_word(data + i + 8) ^ zero_digits) |
+             (load_word(data + i + 16) ^ zero_digits) |
+             (load_word(data + i + 24) ^ zero_digits)) != 0) {
+            break;
+        }
+    }
+    for (; i + 8 <= size; i += 8) {
+        if (auto const diff = load_word(data + i) ^ zero_digits; diff != 0) {
+            auto const zero_bits = std::endian::native == std::endian::little
+                                       ? std::countr_zero(diff)
+                                       : std::countl_zero(diff);
+            return i + static_cast<std::size_t>(zero_bits) / 8;
+        }
+    }
+    while (i != size && data[i] == '0') {
+        ++i;
+    }
+    return i;
+}
+
+inline auto validate_binary_string(std::string_view str) -> void {
+    // Eight characters at a time until a word contains something other
+    // than '0' or '1'; the character loop then finds and reports it.
+    std::size_t i{};
+    for (; i + 8 <= str.size(); i += 8) {
+        if ((load_word(str.data() + i) & 0xfefefefefefefefeu) !=
+            zero_digits) {
+            break;
+        }
+    }
+    for (auto &&ch : str.substr(i)) {
+        details::validate_binary_character(ch);
+    }
+}
+
+inline auto validate_multiple(std::size_t multiple) -> void {
+    if (multiple == 0) [[unlikely]] {
+        EVQOVV_BASE_CONVERSION_ERROR(invalid_multiple);
+        throw std::invalid_argument("base conversion error: multiple is zero");
+    }
+}
+
+// Regroups `digits` from `from_bits` to `to_bits` bits per digit, aligned
+// from the least significant end, and drops the first `skip` output digits.
+// Every digit outside a run of zeros goes through `decode`, which may throw
+// for an invalid one. Output digits go to `put`, most significant first,
+// except that runs of zero output digits are passed to `put_zeros` as a
+// count.
+template <typename Decode, typename Put, typename PutZeros>
+inline auto regroup_digits(std::string_view digits, std::size_t from_bits,
+                           std::size_t to_bits, std::size_t skip,
+                           Decode &&decode, Put &&put, PutZeros &&put_zeros)
+    -> void {
+    auto const total_bits = digits.size() * from_bits;
+    auto const full_size = (total_bits + to_bits - 1) / to_bits;
+
+    unsigned accumulator{};
+    auto pending_bits = full_size * to_bits - total_bits;
+    for (std::size_t i{}; i != digits.size(); ++i) {
+        auto const ch = digits[i];
+
+        // A run of zero digits with no set bits pending only produces zero
+        // digits.
+        if (ch == '0' && (accumulator & ((1u << pending_bits) - 1)) == 0 &&
+            digits.size() - i >= 8 &&
+            details::load_word(digits.data() + i) == details::zero_digits) {
+            auto const run =
+                details::zero_run_length(digits.data() + i, digits.size() - i);
+            auto const bits = pending_bits + run * from_bits;
+            auto const count = bits / to_bits;
+            auto const skipped = std::min(skip, count);
+            skip -= skipped;
+            if (count != skipped) {
+                put_zeros(count - skipped);
+            }
+            pending_bits = bits % to_bits;
+            accumulator = 0;
+            i += run - 1;
+            continue;
+        }
+
+        accumulator = (accumulator << from_bits) |
+                      static_cast<unsigned>(decode(ch));
+        pending_bits += from_bits;
+        while (pending_bits >= to_bits) {
+            pending_bits -= to_bits;
+            if (skip != 0) {
+                --skip;
+                continue;
+            }
+            put(details::decimal_to_hexadecimal_map(static_cast<int>(
+                (accumulator >> pending_bits) & ((1u << to_bits) - 1))));
+        }
+    }
+}
+
+// Regroups digits of one power-of-two base into another, aligned from the
+// least significant end, without an intermediate binary string.
+template <int from_bits, int to_bits, typename Validate, typename Decode>
+inline auto transcode(std::string_view str, Validate validate, Decode decode)
+    -> std::string {
+    auto const digits = details::trim_leading_zeros(str);
+    validate(digits[0]);
+
+    // Sized from the significant bits so that no leading zero has to be
+    // trimmed, and copied, afterwards.
+    auto const leading_bits = static_cast<std::size_t>(
+        std::bit_width(static_cast<unsigned>(decode(digits[0]))));
+    auto const total_bits = (digits.size() - 1) * from_bits + leading_bits;
+    auto const output_size =
+        std::max<std::size_t>((total_bits + to_bits - 1) / to_bits, 1);
+    auto const full_size = (digits.size() * from_bits + to_bits - 1) / to_bits;
+
+    // Zero runs are skipped over, since `result` already holds them.
+    std::string result(output_size, '0');
+    decltype(result.size()) pos{};
+    details::regroup_digits(
+        digits, from_bits, to_bits, full_size - output_size,
+        [&](char ch) {
+            validate(ch);
+            return decode(ch);
+        },
+        [&](char ch) { result[pos++] = ch; },
+        [&](std::size_t count) { pos += count; });
+    return result;
+}
+
+inline auto use_direct_transcode(std::string_view str) noexcept -> bool {
+    return str.size() >= tuning::details::direct_transcode_min_length.load(
+                             std::memory_order_relaxed);
+}
+
+inline auto validate_overflow(uint64_t const &value, int digit, int base) {
+    if (value > (std::numeric_limits<uint64_t>::max() - digit) / base)
+        [[unlikely]] {
+        details::throw_overflow_error();
+    }
+}
+
+inline auto same_base(base radix, std::string_view str) -> std::string {
+    details::validate_string(str);
+
+    switch (radix) {
+    case base::binary:
+        details::validate_binary_string(str);
+        break;
+    case base::octal:
+        for (auto &&ch : str) {
+            details::validate_octal_character(ch);
+        }
+        break;
+    case base::decimal:
+        return std::to_string(
+            details::to_uint64_t(details::trim_leading_zeros(str)));
+    case base::hexadecimal: {
+        for (auto &&ch : str) {
+            details::validate_hexadecimal_character(ch);
+        }
+        // Uppercase, like the output of every other conversion.
+        std::string result(details::trim_leading_zeros(str));
+        for (auto &ch : result) {
+            ch = details::decimal_to_hexadecimal_map(
+                details::hexadecimal_values[static_cast<unsigned char>(ch)]);
+        }
+        return result;
+    }
+    }
+
+    return std::string(details::trim_leading_zeros(str));
+}
+} // namespace details
+} // namespace base_conversion
+} // namespace evqovv
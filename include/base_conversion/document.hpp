@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "../base_conversion.hpp"
+#include "details.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+// An octal or hexadecimal string kept side by side with its binary form.
+// Every input digit owns a fixed-width group of the binary form, so an edit
+// only re-converts the digits it touches; the untrimmed binary form is kept
+// and its leading zeros are located again only when binary() is next called.
+template <base from = base::hexadecimal>
+class binary_document {
+    static_assert(from == base::octal || from == base::hexadecimal);
+
+    static constexpr std::size_t group_size = from == base::octal ? 3 : 4;
+
+public:
+    explicit binary_document(std::string_view input) {
+        details::validate_string(input);
+        validate(input);
+
+        input_ = input;
+        output_.resize(input.size() * group_size);
+        write_groups(0, input);
+    }
+
+    auto input() const noexcept -> std::string_view { return input_; }
+
+    // Same result as octal_to_binary() / hexadecimal_to_binary() on input().
+    auto binary() const -> std::string_view {
+        if (first_one_ == unknown) {
+            first_one_ = output_.find('1');
+        }
+        return first_one_ == std::string::npos
+                   ? std::string_view("0")
+                   : std::string_view(output_).substr(first_one_);
+    }
+
+    auto size() const noexcept -> std::size_t { return input_.size(); }
+
+    // Overwrites digits.size() digits starting at `pos`.
+    auto replace(std::size_t pos, std::string_view digits) -> void {
+        if (pos > input_.size() || digits.size() > input_.size() - pos) {
+            throw_out_of_range();
+        }
+        validate(digits);
+
+        input_.replace(pos, digits.size(), digits);
+        write_groups(pos, digits);
+        touched(pos);
+    }
+
+    auto insert(std::size_t pos, std::string_view digits) -> void {
+        if (pos > input_.size()) {
+            throw_out_of_range();
+        }
+        validate(digits);
+
+        input_.insert(pos, digits);
+        output_.insert(pos * group_size, digits.size() * group_size, '0');
+        write_groups(pos, digits);
+        touched(pos);
+    }
+
+    auto erase(std::size_t pos, std::size_t count) -> void {
+        if (pos > input_.size() || count > input_.size() - pos) {
+            throw_out_of_range();
+        }
+        if (count == input_.size()) {
+            details::validate_string({});
+        }
+
+        input_.erase(pos, count);
+        output_.erase(pos * group_size, count * group_size);
+        touched(pos);
+    }
+
+private:
+    static constexpr auto unknown = std::string::npos - 1;
+
+    static auto validate(std::string_view digits) -> void {
+        for (auto &&ch : digits) {
+            if constexpr (from == base::octal) {
+                details::validate_octal_character(ch);
+            } else {
+                details::validate_hexadecimal_character(ch);
+            }
+        }
+    }
+
+    [[noreturn]] static auto throw_out_of_range() -> void {
+        throw std::out_of_range(
+            "base conversion error: edit is outside the document");
+    }
+
+    auto write_groups(std::size_t pos, std::string_view digits) noexcept
+        -> void {
+        auto *out = output_.data() + pos * group_size;
+        for (auto &&ch : digits) {
+            auto const group = from == base::octal
+                                   ? details::octal_to_binary_map(ch)
+                                   : details::hexadecimal_to_binary_map(ch);
+            out = std::copy(group.begin(), group.end(), out);
+        }
+    }
+
+    // Edits past the first set bit cannot move it.
+    auto touched(std::size_t pos) noexcept -> void {
+        if (first_one_ == unknown || pos * group_size <= first_one_) {
+            first_one_ = unknown;
+        }
+    }
+
+    std::string input_;
+    std::string output_;
+    mutable std::size_t first_one_ = unknown;
+};
+
+using hexadecimal_binary_document = binary_document<base::hexadecimal>;
+using octal_binary_document = binary_document<base::octal>;
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace evqovv {
+namespace base_conversion {
+using bulk_task = std::function<void(std::size_t)>;
+
+// Something that can run task(0) ... task(count - 1), possibly in parallel,
+// and return once all of them have finished. The first exception thrown by
+// a task is rethrown by bulk_execute() after the others have completed.
+template <typename E>
+concept executor = requires(E &e, std::size_t count, bulk_task const &task) {
+    { e.bulk_execute(count, task) } -> std::same_as<void>;
+    { e.concurrency() } -> std::convertible_to<std::size_t>;
+};
+
+namespace details {
+inline auto default_pool_size() noexcept -> std::size_t {
+    return std::max(1u, std::thread::hardware_concurrency()) - 1;
+}
+
+// Index dispenser shared by every thread working on one bulk_execute() call.
+class bulk_job {
+public:
+    bulk_job(std::size_t count, bulk_task const &task) noexcept
+        : count_(count), remaining_(count), task_(task) {}
+
+    // Runs tasks until none are left to claim.
+    auto drain() noexcept -> void {
+        for (auto i = next_.fetch_add(1, std::memory_order_relaxed);
+             i < count_; i = next_.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                task_(i);
+            } catch (...) {
+                std::lock_guard lock(mutex_);
+                if (!failure_) {
+                    failure_ = std::current_exception();
+                }
+            }
+
+            if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard lock(mutex_);
+                done_.notify_all();
+            }
+        }
+    }
+
+    auto wait() -> void {
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [&] {
+            return remaining_.load(std::memory_order_acquire) == 0;
+        });
+        if (failure_) {
+            std::rethrow_exception(failure_);
+        }
+    }
+
+private:
+    std::size_t count_;
+    std::atomic<std::size_t> next_{};
+    std::atomic<std::size_t> remaining_;
+    bulk_task const &task_;
+    std::mutex mutex_;
+    std::condition_variable done_;
+    std::exception_ptr failure_;
+};
+} // namespace details
+
+// Runs every task on the calling thread, in order.
+class inline_executor {
+public:
+    auto bulk_execute(std::size_t count, bulk_task const &task) -> void {
+        for (std::size_t i{}; i != count; ++i) {
+            task(i);
+        }
+    }
+
+    auto concurrency() const noexcept -> std::size_t { return 1; }
+};
+
+// A fixed set of worker threads. The calling thread also works on its own
+// bulk_execute() call, so a pool of N threads runs N + 1 tasks at once.
+class thread_pool {
+public:
+    explicit thread_pool(std::size_t threads = details::default_pool_size()) {
+        workers_.reserve(threads);
+        for (std::size_t i{}; i != threads; ++i) {
+            workers_.emplace_back([this](std::stop_token stop) { run(stop); });
+        }
+    }
+
+    thread_pool(thread_pool const &) = delete;
+    auto operator=(thread_pool const &) -> thread_pool & = delete;
+
+    auto bulk_execute(std::size_t count, bulk_task const &task) -> void {
+        if (count == 0) {
+            return;
+        }
+
+        auto job = std::make_shared<details::bulk_job>(count, task);
+        {
+            std::lock_guard lock(mutex_);
+            jobs_.push_back(job);
+        }
+        wake_.notify_all();
+
+        job->drain();
+        {
+            std::lock_guard lock(mutex_);
+            std::erase(jobs_, job);
+        }
+        job->wait();
+    }
+
+    auto concurrency() const noexcept -> std::size_t {
+        return workers_.size() + 1;
+    }
+
+private:
+    auto run(std::stop_token const &stop) -> void {
+        while (true) {
+            std::shared_ptr<details::bulk_job> job;
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, stop, [&] { return !jobs_.empty(); });
+                if (stop.stop_requested()) {
+                    return;
+                }
+                job = jobs_.front();
+                // Rotate so concurrent callers share the workers.
+                std::rotate(jobs_.begin(), jobs_.begin() + 1, jobs_.end());
+            }
+            job->drain();
+            {
+                std::lock_guard lock(mutex_);
+                std::erase(jobs_, job);
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::vector<std::shared_ptr<details::bulk_job>> jobs_;
+    // Last, so the workers are stopped and joined before anything they use
+    // is destroyed.
+    std::vector<std::jthread> workers_;
+};
+
+// Runs tasks on a pool the host process already owns. `submit` receives a
+// std::function<void()> to run somewhere on that pool; at most
+// `concurrency - 1` are submitted per call and the caller takes part too.
+template <typename Submit>
+class pool_executor {
+public:
+    pool_executor(Submit submit, std::size_t concurrency)
+        : submit_(std::move(submit)),
+          concurrency_(std::max<std::size_t>(concurrency, 1)) {}
+
+    auto bulk_execute(std::size_t count, bulk_task const &task) -> void {
+        if (count == 0) {
+            return;
+        }
+
+        auto job = std::make_shared<details::bulk_job>(count, task);
+        auto const helpers = std::min(count, concurrency_) - 1;
+        for (std::size_t i{}; i != helpers; ++i) {
+            submit_(std::function<void()>([job] { job->drain(); }));
+        }
+        job->drain();
+        job->wait();
+    }
+
+    auto concurrency() const noexcept -> std::size_t { return concurrency_; }
+
+private:
+    Submit submit_;
+    std::size_t concurrency_;
+};
+
+// The pool used by parallel entry points that are not given an executor.
+// Created on first use with one thread per hardware thread, less the caller.
+inline auto default_executor() -> thread_pool & {
+    static thread_pool pool;
+    return pool;
+}
+} // namespace base_conversion
+} // namespace evqovv
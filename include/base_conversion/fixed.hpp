@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "buffer.hpp"
+#include "details.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+// Result of the fixed-length conversions: the digits without leading zeros,
+// stored inline.
+template <std::size_t Capacity>
+struct fixed_result {
+    std::array<char, Capacity> chars{};
+    std::size_t size{};
+
+    auto view() const noexcept -> std::string_view {
+        return {chars.data(), size};
+    }
+
+    operator std::string_view() const noexcept { return view(); }
+};
+
+namespace details {
+template <std::size_t Bits>
+using fixed_value = std::conditional_t<(Bits <= 64), std::uint64_t, uint128>;
+
+template <base radix, std::size_t Bits>
+inline constexpr std::size_t fixed_capacity =
+    radix == base::decimal
+        ? Bits * 1233 / 4096 + 1 // floor(Bits * log10(2)) + 1
+        : (Bits + static_cast<std::size_t>(bits_per_digit(radix)) - 1) /
+              static_cast<std::size_t>(bits_per_digit(radix));
+
+inline auto throw_fixed_length_error(std::size_t expected) -> void {
+    throw std::invalid_argument("base conversion error: expected " +
+                                std::to_string(expected) + " characters");
+}
+
+// Reports the first invalid character of a fixed-length input.
+inline auto throw_fixed_digit_error(base from, std::string_view str)
+    -> void {
+    for (auto &&ch : str) {
+        if (digit_value(from, ch) < 0) {
+            throw_invalid_character_error(ch);
+        }
+    }
+}
+
+template <base from, std::size_t N>
+auto parse_fixed(std::string_view str)
+    -> fixed_value<N * static_cast<std::size_t>(bits_per_digit(from))> {
+    constexpr auto digit_bits = static_cast<std::size_t>(bits_per_digit(from));
+    using value_type = fixed_value<N * digit_bits>;
+
+    if (str.size() != N) {
+        throw_fixed_length_error(N);
+    }
+    auto const *data = str.data();
+
+    value_type value{};
+    bool valid;
+    if constexpr (from == base::binary && N % 8 == 0) {
+        // Eight digits per word: one mask check and one multiply each.
+        valid = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((value = value << 8 |
+                      static_cast<value_type>(pack_binary_byte(data + 8 * I))),
+             ...);
+            return (((load_word(data + 8 * I) & 0xfefefefefefefefeu) ^
+                     zero_digits) |
+                    ...) == 0;
+        }(std::make_index_sequence<N / 8>{});
+    } else {
+        valid = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            constexpr auto const &table = hexadecimal_values;
+            auto const digits = std::array<signed char, N>{
+                table[static_cast<unsigned char>(data[I])]...};
+            ((value = value << digit_bits |
+                      static_cast<value_type>(
+                          static_cast<unsigned char>(digits[I]))),
+             ...);
+            return (digits[I] | ...) >= 0 &&
+                   ((static_cast<std::size_t>(digits[I]) >> digit_bits) |
+                    ...) == 0;
+        }(std::make_index_sequence<N>{});
+    }
+
+    if (!valid) {
+        throw_fixed_digit_error(from, str);
+    }
+    return value;
+}
+
+// Writes every digit of the full width, then moves the significant ones to
+// the front.
+template <base to, std::size_t Bits>
+auto format_fixed(fixed_value<Bits> value) noexcept
+    -> fixed_result<fixed_capacity<to, Bits>> {
+    constexpr auto capacity = fixed_capacity<to, Bits>;
+    fixed_result<capacity> result;
+    auto *out = result.chars.data();
+
+    if constexpr (to == base::decimal) {
+        if constexpr (Bits <= 64) {
+            result.size = static_cast<std::size_t>(
+                std::to_chars(out, out + capacity, value).ptr - out);
+        } else {
+            constexpr std::uint64_t group = 10'000'000'000'000'000'000u;
+            auto const low = static_cast<std::uint64_t>(value % group);
+            value /= group;
+            auto const middle = static_cast<std::uint64_t>(value % group);
+            auto const high = static_cast<std::uint64_t>(value / group);
+
+            auto *end = out;
+            auto const put = [&](std::uint64_t part, bool pad) {
+                if (pad) {
+                    auto *const group_end = end + 19;
+                    std::fill(end, group_end, '0');
+                    auto const written = std::to_chars(end, group_end, part);
+                    std::rotate(end, written.ptr, group_end);
+                    end = group_end;
+                } else {
+                    end = std::to_chars(end, out + capacity, part).ptr;
+                }
+            };
+            if (high != 0) {
+                put(high, false);
+                put(middle, true);
+                put(low, true);
+            } else if (middle != 0) {
+                put(middle, false);
+                put(low, true);
+            } else {
+                put(low, false);
+            }
+            result.size = static_cast<std::size_t>(end - out);
+        }
+    } else {
+        constexpr auto digit_bits =
+            static_cast<std::size_t>(bits_per_digit(to));
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((out[I] = decimal_to_hexadecimal_map(static_cast<int>(
+                  (value >> (digit_bits * (capacity - 1 - I))) &
+                  ((1u << digit_bits) - 1)))),
+             ...);
+        }(std::make_index_sequence<capacity>{});
+
+        std::size_t first{};
+        while (first + 1 != capacity && out[first] == '0') {
+            ++first;
+        }
+        result.size = capacity - first;
+        std::copy(out + first, out + capacity, out);
+    }
+    return result;
+}
+} // namespace details
+
+// Fixed-length forms of the conversions for inputs of exactly N digits,
+// such as 16-digit span IDs, 32-digit trace IDs or 64-digit masks. The
+// digits are loaded and checked by a fully unrolled sequence with no loop
+// over the input, and the result is returned inline.
+template <std::size_t N>
+    requires(N >= 1 && N <= 32)
+auto hexadecimal_to_decimal(std::string_view str)
+    -> fixed_result<details::fixed_capacity<base::decimal, N * 4>> {
+    return details::format_fixed<base::decimal, N * 4>(
+        details::parse_fixed<base::hexadecimal, N>(str));
+}
+
+template <std::size_t N>
+    requires(N >= 1 && N <= 32)
+auto hexadecimal_to_binary(std::string_view str)
+    -> fixed_result<details::fixed_capacity<base::binary, N * 4>> {
+    return details::format_fixed<base::binary, N * 4>(
+        details::parse_fixed<base::hexadecimal, N>(str));
+}
+
+template <std::size_t N>
+    requires(N >= 1 && N <= 128)
+auto binary_to_hexadecimal(std::string_view str)
+    -> fixed_result<details::fixed_capacity<base::hexadecimal, N>> {
+    return details::format_fixed<base::hexadecimal, N>(
+        details::parse_fixed<base::binary, N>(str));
+}
+
+template <std::size_t N>
+    requires(N >= 1 && N <= 128)
+auto binary_to_decimal(std::string_view str)
+    -> fixed_result<details::fixed_capacity<base::decimal, N>> {
+    return details::format_fixed<base::decimal, N>(
+        details::parse_fixed<base::binary, N>(str));
+}
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace evqovv {
+namespace base_conversion {
+namespace instrumentation {
+enum class function_id : unsigned char {
+    zero_padding,
+    binary_to_octal,
+    binary_to_decimal,
+    binary_to_hexadecimal,
+    octal_to_binary,
+    octal_to_decimal,
+    octal_to_hexadecimal,
+    decimal_to_binary,
+    decimal_to_octal,
+    decimal_to_hexadecimal,
+    hexadecimal_to_binary,
+    hexadecimal_to_octal,
+    hexadecimal_to_decimal,
+    count,
+};
+
+enum class error_kind : unsigned char {
+    empty_string,
+    invalid_character,
+    overflow,
+    invalid_multiple,
+    other,
+    count,
+};
+
+inline constexpr auto function_count =
+    static_cast<std::size_t>(function_id::count);
+inline constexpr auto error_kind_count =
+    static_cast<std::size_t>(error_kind::count);
+
+inline constexpr auto function_name(function_id id) noexcept
+    -> std::string_view {
+    constexpr std::array<std::string_view, function_count> names{
+        "zero_padding",          "binary_to_octal",
+        "binary_to_decimal",     "binary_to_hexadecimal",
+        "octal_to_binary",       "octal_to_decimal",
+        "octal_to_hexadecimal",  "decimal_to_binary",
+        "decimal_to_octal",      "decimal_to_hexadecimal",
+        "hexadecimal_to_binary", "hexadecimal_to_octal",
+        "hexadecimal_to_decimal"};
+
+    return names[static_cast<std::size_t>(id)];
+}
+
+inline constexpr auto error_kind_name(error_kind kind) noexcept
+    -> std::string_view {
+    constexpr std::array<std::string_view, error_kind_count> names{
+        "empty_string", "invalid_character", "overflow", "invalid_multiple",
+        "other"};
+
+    return names[static_cast<std::size_t>(kind)];
+}
+
+namespace details {
+inline thread_local error_kind last_error = error_kind::other;
+
+inline auto record_error(error_kind kind) noexcept -> void {
+    last_error = kind;
+}
+} // namespace details
+} // namespace instrumentation
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,421 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "function_id.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace evqovv {
+namespace base_conversion {
+namespace metrics {
+using instrumentation::error_kind;
+using instrumentation::error_kind_count;
+using instrumentation::error_kind_name;
+using instrumentation::function_count;
+using instrumentation::function_id;
+using instrumentation::function_name;
+
+// Bucket i counts inputs whose length has bit width i, i.e. lengths in
+// [2^(i-1), 2^i); bucket 0 holds empty inputs.
+inline constexpr std::size_t length_bucket_count = 65;
+
+// Log-linear latency buckets in the style of HdrHistogram: values below 8
+// ticks get a bucket each, every further power of two is split into 8 linear
+// sub-buckets, and anything at or above 2^40 ticks lands in the last bucket.
+inline constexpr std::size_t latency_sub_bucket_bits = 3;
+inline constexpr std::size_t latency_max_bits = 40;
+inline constexpr std::size_t latency_bucket_count =
+    (latency_max_bits - latency_sub_bucket_bits + 1)
+    << latency_sub_bucket_bits;
+
+inline constexpr auto latency_bucket_index(std::uint64_t ticks) noexcept
+    -> std::size_t {
+    constexpr std::uint64_t sub_bucket_count = 1u << latency_sub_bucket_bits;
+    constexpr std::uint64_t max_ticks =
+        (std::uint64_t{1} << latency_max_bits) - 1;
+
+    if (ticks > max_ticks) {
+        ticks = max_ticks;
+    }
+    if (ticks < sub_bucket_count) {
+        return static_cast<std::size_t>(ticks);
+    }
+
+    auto const shift = static_cast<std::size_t>(std::bit_width(ticks)) - 1 -
+                       latency_sub_bucket_bits;
+    return ((shift + 1) << latency_sub_bucket_bits) +
+           static_cast<std::size_t>((ticks >> shift) & (sub_bucket_count - 1));
+}
+
+inline constexpr auto latency_bucket_lower_bound(std::size_t index) noexcept
+    -> std::uint64_t {
+    constexpr std::uint64_t sub_bucket_count = 1u << latency_sub_bucket_bits;
+
+    auto const group = index >> latency_sub_bucket_bits;
+    auto const sub_bucket = index & (sub_bucket_count - 1);
+    return group == 0 ? sub_bucket : (sub_bucket_count + sub_bucket)
+                                          << (group - 1);
+}
+
+struct function_counters {
+    std::uint64_t calls{};
+    std::uint64_t bytes_in{};
+    std::uint64_t bytes_out{};
+    std::array<std::uint64_t, error_kind_count> errors{};
+    std::array<std::uint64_t, length_bucket_count> input_lengths{};
+    std::uint64_t latency_samples{};
+    std::uint64_t latency_ticks_sum{};
+    std::array<std::uint64_t, latency_bucket_count> latency_ticks{};
+};
+
+struct snapshot {
+    std::array<function_counters, function_count> functions{};
+    double ticks_per_second{};
+};
+
+// Returns the estimated q-quantile (0 <= q <= 1) of the sampled latencies in
+// ticks, or 0 when nothing was sampled.
+inline auto latency_quantile(function_counters const &counters,
+                             double q) noexcept -> double {
+    if (counters.latency_samples == 0) {
+        return 0;
+    }
+
+    auto const rank = static_cast<std::uint64_t>(
+        q * static_cast<double>(counters.latency_samples - 1));
+    std::uint64_t seen{};
+    for (std::size_t b{}; b != latency_bucket_count; ++b) {
+        seen += counters.latency_ticks[b];
+        if (seen > rank) {
+            auto const lower = latency_bucket_lower_bound(b);
+            auto const upper = b + 1 == latency_bucket_count
+                                   ? lower
+                                   : latency_bucket_lower_bound(b + 1) - 1;
+            return (static_cast<double>(lower) + static_cast<double>(upper)) /
+                   2;
+        }
+    }
+
+    return static_cast<double>(
+        latency_bucket_lower_bound(latency_bucket_count - 1));
+}
+
+namespace details {
+struct atomic_function_counters {
+    std::atomic<std::uint64_t> calls{};
+    std::atomic<std::uint64_t> bytes_in{};
+    std::atomic<std::uint64_t> bytes_out{};
+    std::array<std::atomic<std::uint64_t>, error_kind_count> errors{};
+    std::array<std::atomic<std::uint64_t>, length_bucket_count>
+        input_lengths{};
+    std::atomic<std::uint64_t> latency_samples{};
+    std::atomic<std::uint64_t> latency_ticks_sum{};
+    std::array<std::atomic<std::uint64_t>, latency_bucket_count>
+        latency_ticks{};
+};
+
+// Each block is written only by its owning thread, so increments are a
+// relaxed load and store rather than a locked read-modify-write.
+inline auto bump(std::atomic<std::uint64_t> &counter,
+                 std::uint64_t amount = 1) noexcept -> void {
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+}
+
+struct alignas(64) thread_counters {
+    std::array<atomic_function_counters, function_count> functions{};
+
+    auto add_to(snapshot &out) const noexcept -> void {
+        for (std::size_t f{}; f != function_count; ++f) {
+            auto const &src = functions[f];
+            auto &dst = out.functions[f];
+            dst.calls += src.calls.load(std::memory_order_relaxed);
+            dst.bytes_in += src.bytes_in.load(std::memory_order_relaxed);
+            dst.bytes_out += src.bytes_out.load(std::memory_order_relaxed);
+            for (std::size_t k{}; k != error_kind_count; ++k) {
+                dst.errors[k] +=
+                    src.errors[k].load(std::memory_order_relaxed);
+            }
+            for (std::size_t b{}; b != length_bucket_count; ++b) {
+                dst.input_lengths[b] +=
+                    src.input_lengths[b].load(std::memory_order_relaxed);
+            }
+            dst.latency_samples +=
+                src.latency_samples.load(std::memory_order_relaxed);
+            dst.latency_ticks_sum +=
+                src.latency_ticks_sum.load(std::memory_order_relaxed);
+            for (std::size_t b{}; b != latency_bucket_count; ++b) {
+                dst.latency_ticks[b] +=
+                    src.latency_ticks[b].load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+class registry {
+public:
+    auto attach() -> std::shared_ptr<thread_counters> {
+        auto block = std::make_shared<thread_counters>();
+        std::lock_guard lock(mutex_);
+        live_.push_back(block);
+        return block;
+    }
+
+    auto retire(std::shared_ptr<thread_counters> const &block) -> void {
+        std::lock_guard lock(mutex_);
+        block->add_to(retired_);
+        std::erase(live_, block);
+    }
+
+    auto collect() const -> snapshot {
+        std::lock_guard lock(mutex_);
+        auto result = retired_;
+        for (auto const &block : live_) {
+            block->add_to(result);
+        }
+        return result;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<thread_counters>> live_;
+    snapshot retired_{};
+};
+
+inline auto global_registry() -> registry & {
+    static registry instance;
+    return instance;
+}
+
+// Folds the thread's counts into the registry when the thread exits so that
+// short-lived threads neither lose their counts nor leak blocks.
+class thread_slot {
+public:
+    thread_slot() : block_(global_registry().attach()) {}
+
+    thread_slot(thread_slot const &) = delete;
+    auto operator=(thread_slot const &) -> thread_slot & = delete;
+
+    ~thread_slot() { global_registry().retire(block_); }
+
+    auto counters() noexcept -> thread_counters & { return *block_; }
+
+private:
+    std::shared_ptr<thread_counters> block_;
+};
+
+inline auto local_counters() -> thread_counters & {
+    thread_local thread_slot slot;
+    return slot.counters();
+}
+
+inline auto read_ticks() noexcept -> std::uint64_t {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+struct tick_origin {
+    std::uint64_t ticks = read_ticks();
+    std::chrono::steady_clock::time_point time =
+        std::chrono::steady_clock::now();
+};
+
+// Taken during static initialization, so that the rate below is measured
+// against steady_clock over the whole process lifetime without waiting.
+inline tick_origin const process_tick_origin{};
+
+inline auto ticks_per_second() -> double {
+    auto const ticks = read_ticks();
+    std::chrono::duration<double> const elapsed =
+        std::chrono::steady_clock::now() - process_tick_origin.time;
+    return static_cast<double>(ticks - process_tick_origin.ticks) /
+           elapsed.count();
+}
+
+inline std::atomic<std::uint32_t> latency_sample_interval{1024};
+
+inline thread_local std::uint32_t latency_countdown{1};
+
+inline auto should_sample_latency() noexcept -> bool {
+    if (--latency_countdown != 0) [[likely]] {
+        return false;
+    }
+
+    auto const interval =
+        latency_sample_interval.load(std::memory_order_relaxed);
+    latency_countdown = interval == 0 ? 1024 : interval;
+    return interval != 0;
+}
+
+class recorder {
+public:
+    recorder(function_id id, std::size_t input_size)
+        : counters_(
+              local_counters().functions[static_cast<std::size_t>(id)]) {
+        bump(counters_.calls);
+        bump(counters_.bytes_in, input_size);
+        bump(counters_.input_lengths[std::bit_width(input_size)]);
+        if (should_sample_latency()) [[unlikely]] {
+            start_ticks_ = read_ticks();
+        }
+    }
+
+    recorder(recorder const &) = delete;
+    auto operator=(recorder const &) -> recorder & = delete;
+
+    ~recorder() {
+        if (start_ticks_ != 0) [[unlikely]] {
+            auto const elapsed = read_ticks() - start_ticks_;
+            bump(counters_.latency_samples);
+            bump(counters_.latency_ticks_sum, elapsed);
+            bump(counters_.latency_ticks[latency_bucket_index(elapsed)]);
+        }
+    }
+
+    auto output(std::size_t output_size) noexcept -> void {
+        bump(counters_.bytes_out, output_size);
+    }
+
+    auto fail(error_kind kind) noexcept -> void {
+        bump(counters_.errors[static_cast<std::size_t>(kind)]);
+    }
+
+private:
+    atomic_function_counters &counters_;
+    std::uint64_t start_ticks_{};
+};
+} // namespace details
+
+// Times one call in every `interval` per thread; 0 turns latency sampling
+// off. The default of 1024 keeps the timing overhead well under 1%.
+inline auto set_latency_sample_interval(std::uint32_t interval) noexcept
+    -> void {
+    details::latency_sample_interval.store(interval,
+                                           std::memory_order_relaxed);
+}
+
+inline auto take_snapshot() -> snapshot {
+    auto result = details::global_registry().collect();
+    result.ticks_per_second = details::ticks_per_second();
+    return result;
+}
+
+inline auto to_prometheus(snapshot const &snap) -> std::string {
+    std::string result;
+
+    auto const counter = [&](std::string_view name, std::string_view help,
+                             auto field) {
+        result += std::format("# HELP evqovv_base_conversion_{} {}\n"
+                              "# TYPE evqovv_base_conversion_{} counter\n",
+                              name, help, name);
+        for (std::size_t f{}; f != function_count; ++f) {
+            result += std::format(
+                "evqovv_base_conversion_{}{{function=\"{}\"}} {}\n", name,
+                function_name(static_cast<function_id>(f)),
+                snap.functions[f].*field);
+        }
+    };
+
+    counter("calls_total", "Number of conversion calls.",
+            &function_counters::calls);
+    counter("input_bytes_total", "Bytes of input passed to conversions.",
+            &function_counters::bytes_in);
+    counter("output_bytes_total", "Bytes of output produced by conversions.",
+            &function_counters::bytes_out);
+
+    result += "# HELP evqovv_base_conversion_errors_total Number of failed "
+              "conversion calls.\n"
+              "# TYPE evqovv_base_conversion_errors_total counter\n";
+    for (std::size_t f{}; f != function_count; ++f) {
+        for (std::size_t k{}; k != error_kind_count; ++k) {
+            result += std::format(
+                "evqovv_base_conversion_errors_total{{function=\"{}\",kind="
+                "\"{}\"}} {}\n",
+                function_name(static_cast<function_id>(f)),
+                error_kind_name(static_cast<error_kind>(k)),
+                snap.functions[f].errors[k]);
+        }
+    }
+
+    std::size_t used_buckets{1};
+    for (auto const &counters : snap.functions) {
+        for (std::size_t b{}; b != length_bucket_count; ++b) {
+            if (counters.input_lengths[b] != 0 && b + 1 > used_buckets) {
+                used_buckets = b + 1;
+            }
+        }
+    }
+
+    result += "# HELP evqovv_base_conversion_input_length Input length in "
+              "bytes, log2 buckets.\n"
+              "# TYPE evqovv_base_conversion_input_length histogram\n";
+    for (std::size_t f{}; f != function_count; ++f) {
+        auto const name = function_name(static_cast<function_id>(f));
+        auto const &counters = snap.functions[f];
+
+        std::uint64_t cumulative{};
+        for (std::size_t b{}; b != used_buckets && b != 64; ++b) {
+            cumulative += counters.input_lengths[b];
+            result += std::format("evqovv_base_conversion_input_length_bucket{{"
+                                  "function=\"{}\",le=\"{}\"}} {}\n",
+                                  name, (std::uint64_t{1} << b) - 1,
+                                  cumulative);
+        }
+        result += std::format("evqovv_base_conversion_input_length_bucket{{"
+                              "function=\"{}\",le=\"+Inf\"}} {}\n"
+                              "evqovv_base_conversion_input_length_sum{{"
+                              "function=\"{}\"}} {}\n"
+                              "evqovv_base_conversion_input_length_count{{"
+                              "function=\"{}\"}} {}\n",
+                              name, counters.calls, name, counters.bytes_in,
+                              name, counters.calls);
+    }
+
+    result += "# HELP evqovv_base_conversion_latency_seconds Sampled "
+              "conversion latency.\n"
+              "# TYPE evqovv_base_conversion_latency_seconds summary\n";
+    for (std::size_t f{}; f != function_count; ++f) {
+        auto const name = function_name(static_cast<function_id>(f));
+        auto const &counters = snap.functions[f];
+
+        for (auto const q : {0.5, 0.9, 0.99, 0.999}) {
+            result += std::format("evqovv_base_conversion_latency_seconds{{"
+                                  "function=\"{}\",quantile=\"{}\"}} {}\n",
+                                  name, q,
+                                  latency_quantile(counters, q) /
+                                      snap.ticks_per_second);
+        }
+        result += std::format(
+            "evqovv_base_conversion_latency_seconds_sum{{function=\"{}\"}} "
+            "{}\n"
+            "evqovv_base_conversion_latency_seconds_count{{function=\"{}\"}} "
+            "{}\n",
+            name,
+            static_cast<double>(counters.latency_ticks_sum) /
+                snap.ticks_per_second,
+            name, counters.latency_samples);
+    }
+
+    return result;
+}
+} // namespace metrics
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <numeric>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../base_conversion.hpp"
+#include "buffer.hpp"
+#include "cancellation.hpp"
+#include "details.hpp"
+#include "executor.hpp"
+#include "trace.hpp"
+#include "tuning.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+struct parallel_options {
+    // Upper bound on the number of tasks; 0 uses the executor's concurrency.
+    unsigned threads = 0;
+    // Pin each task to the NUMA node holding its input range and prefer
+    // that node for its output range. The thread's previous affinity is
+    // restored when its share of the work ends. Ignored on single-node
+    // machines.
+    bool numa_pinning = false;
+};
+
+namespace details {
+// Input digits per chunk before rounding up to whole output groups. Chunks
+// are the unit of work, of cancellation and of error ordering.
+inline constexpr std::size_t parallel_chunk_digits = std::size_t{1} << 18;
+
+#ifdef __linux__
+inline auto numa_node_count() -> int {
+    static int const count = [] {
+        // "0" on a single node, "0-1" or "0,2-3" otherwise.
+        std::ifstream file("/sys/devices/system/node/online");
+        std::string online;
+        if (!std::getline(file, online) || online.empty()) {
+            return 1;
+        }
+        auto const last = online.find_last_of(",-");
+        auto const tail = std::string_view(online).substr(
+            last == std::string::npos ? 0 : last + 1);
+        int highest{};
+        std::from_chars(tail.data(), tail.data() + tail.size(), highest);
+        return highest + 1;
+    }();
+    return count;
+}
+
+// The node backing `address`, or -1 when it cannot be determined.
+inline auto numa_node_of(void const *address) noexcept -> int {
+    constexpr unsigned long mpol_f_node = 1;
+    constexpr unsigned long mpol_f_addr = 2;
+
+    int node = -1;
+    if (::syscall(SYS_get_mempolicy, &node, nullptr, 0UL, address,
+                  mpol_f_node | mpol_f_addr) != 0) {
+        return -1;
+    }
+    return node;
+}
+
+// Restricts the calling thread to the CPUs of `node` until destroyed, then
+// restores its previous affinity. Best effort: on any failure the affinity
+// is left as it was.
+class numa_pin {
+public:
+    explicit numa_pin(int node) noexcept {
+        if (::sched_getaffinity(0, sizeof(previous_), &previous_) == 0) {
+            try {
+                pinned_ = pin_to(node);
+            } catch (...) {
+            }
+        }
+    }
+
+    numa_pin(numa_pin const &) = delete;
+    auto operator=(numa_pin const &) -> numa_pin & = delete;
+
+    ~numa_pin() {
+        if (pinned_) {
+            ::sched_setaffinity(0, sizeof(previous_), &previous_);
+        }
+    }
+
+private:
+    static auto pin_to(int node) -> bool {
+        std::ifstream file("/sys/devices/system/node/node" +
+                           std::to_string(node) + "/cpulist");
+        std::string cpulist;
+        if (!std::getline(file, cpulist)) {
+            return false;
+        }
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        std::string_view rest(cpulist);
+        while (!rest.empty()) {
+            auto const comma = rest.find(',');
+            auto const range = rest.substr(0, comma);
+            rest = comma == std::string_view::npos ? std::string_view()
+                                                   : rest.substr(comma + 1);
+
+            int first{};
+            auto const *end = range.data() + range.size();
+            auto [ptr, ec] = std::from_chars(range.data(), end, first);
+            auto last = first;
+            if (ptr != end && *ptr == '-') {
+                std::from_chars(ptr + 1, end, last);
+            }
+            for (auto cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        return ::sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+    }
+
+    cpu_set_t previous_;
+    bool pinned_{};
+};
+
+// Best effort: pages straddling the range boundaries are left alone.
+inline auto prefer_numa_node(char *begin, std::size_t size, int node) noexcept
+    -> void {
+    constexpr int mpol_preferred = 1;
+
+    auto const page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    auto const first =
+        (reinterpret_cast<std::uintptr_t>(begin) + page - 1) / page * page;
+    auto const last = (reinterpret_cast<std::uintptr_t>(begin) + size) /
+                      page * page;
+    if (first >= last || node < 0 ||
+        node >= static_cast<int>(sizeof(unsigned long) * 8)) {
+        return;
+    }
+
+    unsigned long const mask = 1UL << node;
+    ::syscall(SYS_mbind, first, last - first, mpol_preferred, &mask,
+              sizeof(mask) * 8, 0U);
+}
+
+#else
+inline auto numa_node_count() -> int { return 1; }
+
+inline auto numa_node_of(void const *) noexcept -> int { return -1; }
+
+class numa_pin {
+public:
+    explicit numa_pin(int) noexcept {}
+};
+
+inline auto prefer_numa_node(char *, std::size_t, int) noexcept -> void {}
+#endif
+
+inline auto use_parallel(std::string_view str) noexcept -> bool {
+    return str.size() >= tuning::details::parallel_min_length.load(
+                             std::memory_order_relaxed);
+}
+
+// Always splits the work; convert_parallel() decides whether to call it.
+template <executor Executor>
+auto transcode_parallel(Executor &executor, base from, base to,
+                        std::string_view str, parallel_options const &options,
+                        std::stop_token const &token) -> std::string {
+    auto const digits = [&] {
+        EVQOVV_BASE_CONVERSION_SPAN("prescan", str.size());
+        return details::trim_leading_zeros(str);
+    }();
+    if (details::digit_value(from, digits[0]) < 0) {
+        details::throw_invalid_character_error(digits[0]);
+    }
+
+    auto const from_bits =
+        static_cast<std::size_t>(details::bits_per_digit(from));
+    auto const to_bits = static_cast<std::size_t>(details::bits_per_digit(to));
+    auto const n = digits.size();
+    auto const full_size = (n * from_bits + to_bits - 1) / to_bits;
+    auto const size = details::regrouped_size(from, to, digits);
+    auto const skip = full_size - size;
+
+    // Chunk boundaries are counted from the least significant digit so that
+    // every chunk but the first covers a whole number of output groups.
+    auto const group_digits = std::lcm(from_bits, to_bits) / from_bits;
+    auto const chunk_digits = (details::parallel_chunk_digits +
+                               group_digits - 1) / group_digits * group_digits;
+    auto const chunk_count = (n + chunk_digits - 1) / chunk_digits;
+    auto const task_count = std::min<std::size_t>(
+        options.threads == 0 ? executor.concurrency() : options.threads,
+        chunk_count);
+    auto const pin = options.numa_pinning && details::numa_node_count() > 1;
+
+    std::vector<char> bad_chars(chunk_count);
+    std::atomic<std::size_t> first_bad_chunk{chunk_count};
+    std::exception_ptr failure;
+
+    std::string result;
+    result.resize_and_overwrite(size, [&](char *out, std::size_t) {
+        auto const chunk_range = [&](std::size_t chunk) {
+            auto const last = n - (chunk_count - 1 - chunk) * chunk_digits;
+            return std::pair(chunk == 0 ? 0 : last - chunk_digits, last);
+        };
+        auto const output_first = [&](std::size_t first) {
+            return full_size -
+                   ((n - first) * from_bits + to_bits - 1) / to_bits;
+        };
+
+        auto const work = [&](std::size_t task) {
+            auto const begin = chunk_count * task / task_count;
+            auto const end = chunk_count * (task + 1) / task_count;
+            EVQOVV_BASE_CONVERSION_SPAN("task", end - begin);
+
+            std::optional<details::numa_pin> pinned;
+            if (pin) {
+                auto const node = details::numa_node_of(
+                    digits.data() + chunk_range(begin).first);
+                if (node >= 0) {
+                    pinned.emplace(node);
+                    auto const out_begin =
+                        std::max(output_first(chunk_range(begin).first), skip);
+                    auto const out_end =
+                        output_first(chunk_range(end - 1).second);
+                    details::prefer_numa_node(out + out_begin - skip,
+                                              out_end - out_begin, node);
+                }
+            }
+
+            for (auto chunk = begin; chunk != end; ++chunk) {
+                if (token.stop_requested() ||
+                    chunk > first_bad_chunk.load(std::memory_order_relaxed)) {
+                    return;
+                }
+
+                EVQOVV_BASE_CONVERSION_SPAN("chunk", chunk);
+                auto const [first, last] = chunk_range(chunk);
+                auto const input = digits.substr(first, last - first);
+                auto const bad = std::find_if(input.begin(), input.end(),
+                                              [&](char ch) {
+                    return details::digit_value(from, ch) < 0;
+                });
+                if (bad != input.end()) {
+                    bad_chars[chunk] = *bad;
+                    auto current =
+                        first_bad_chunk.load(std::memory_order_relaxed);
+                    while (chunk < current &&
+                           !first_bad_chunk.compare_exchange_weak(
+                               current, chunk, std::memory_order_relaxed)) {
+                    }
+                    return;
+                }
+
+                auto const chunk_first = output_first(first);
+                auto const chunk_size =
+                    (input.size() * from_bits + to_bits - 1) / to_bits;
+                auto const chunk_skip =
+                    skip > chunk_first
+                        ? std::min(skip - chunk_first, chunk_size)
+                        : 0;
+                auto *dest = out + (chunk_first + chunk_skip - skip);
+                details::regroup_each(from, to, input, chunk_size - chunk_skip,
+                                      [&](char ch) { *dest++ = ch; });
+            }
+        };
+
+        try {
+            EVQOVV_BASE_CONVERSION_SPAN("dispatch", task_count);
+            executor.bulk_execute(task_count, work);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        return size;
+    });
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    if (auto const chunk = first_bad_chunk.load(); chunk != chunk_count) {
+        details::throw_invalid_character_error(bad_chars[chunk]);
+    }
+    if (token.stop_requested()) {
+        throw conversion_cancelled();
+    }
+    return result;
+}
+} // namespace details
+
+// convert() for large power-of-two inputs, split into chunks aligned on
+// whole output groups and run as tasks on `executor`. Each task owns a
+// contiguous run of chunks and is the first to touch its part of the output.
+// Inputs shorter than tuning's parallel_min_length, and conversions to or
+// from decimal, run on the calling thread. A stop request is seen by every
+// task at its next chunk and throws conversion_cancelled.
+template <executor Executor>
+auto convert_parallel(Executor &executor, base from, base to,
+                      std::string_view str,
+                      parallel_options const &options = {},
+                      std::stop_token token = {}) -> std::string {
+    if (from == base::decimal || to == base::decimal || from == to ||
+        !details::use_parallel(str)) {
+        return base_conversion::convert(from, to, str, std::move(token));
+    }
+
+    return details::transcode_parallel(executor, from, to, str, options,
+                                       token);
+}
+
+// convert_parallel() on default_executor().
+inline auto convert_parallel(base from, base to, std::string_view str,
+                             parallel_options const &options = {},
+                             std::stop_token token = {}) -> std::string {
+    return base_conversion::convert_parallel(default_executor(), from, to, str,
+                                             options, std::move(token));
+}
+} // namespace base_conversion
+} // namespace evqovv
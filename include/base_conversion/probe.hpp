@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <utility>
+
+#include "function_id.hpp"
+
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+#include "metrics.hpp"
+#endif
+
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_USDT
+#include "tracepoints.hpp"
+#endif
+
+namespace evqovv {
+namespace base_conversion {
+namespace instrumentation {
+namespace details {
+// Scoped around the body of a public conversion. A call that leaves by
+// exception is attributed to the error kind its throw site recorded. With
+// USDT only, the outcome is tracked just while a tracer is attached.
+class probe {
+public:
+    probe(function_id id, std::size_t input_size)
+        :
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+          recorder_(id, input_size),
+#endif
+          id_(id), input_size_(input_size) {
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_USDT
+        tracing_ = tracepoints::details::enabled();
+#endif
+        if (active()) {
+            uncaught_ = std::uncaught_exceptions();
+            last_error = error_kind::other;
+        }
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_USDT
+        if (tracing_) [[unlikely]] {
+            tracepoints::details::fire_entry(id_, input_size_);
+        }
+#endif
+    }
+
+    probe(probe const &) = delete;
+    auto operator=(probe const &) -> probe & = delete;
+
+    ~probe() {
+        if (!active()) {
+            return;
+        }
+
+        auto const failed = std::uncaught_exceptions() > uncaught_;
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+        if (failed) [[unlikely]] {
+            recorder_.fail(last_error);
+        }
+#endif
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_USDT
+        if (tracing_) [[unlikely]] {
+            if (failed) {
+                tracepoints::details::fire_error(id_, input_size_,
+                                                 last_error);
+            }
+            tracepoints::details::fire_exit(
+                id_, input_size_,
+                failed ? static_cast<unsigned>(last_error) + 1 : 0u,
+                output_size_);
+        }
+#endif
+        static_cast<void>(failed);
+    }
+
+    // Hands the result straight back so it can be returned in place.
+    auto complete(std::string &result) noexcept -> std::string && {
+        record_output(result.size());
+        return std::move(result);
+    }
+
+    auto complete(std::string &&result) noexcept -> std::string && {
+        record_output(result.size());
+        return std::move(result);
+    }
+
+private:
+    auto active() const noexcept -> bool {
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+        return true;
+#else
+        return tracing_;
+#endif
+    }
+
+    auto record_output(std::size_t output_size) noexcept -> void {
+        output_size_ = output_size;
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+        recorder_.output(output_size);
+#endif
+    }
+
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+    metrics::details::recorder recorder_;
+#endif
+    function_id id_;
+    std::size_t input_size_;
+    std::size_t output_size_{};
+    int uncaught_{};
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_USDT
+    bool tracing_{};
+#endif
+};
+} // namespace details
+} // namespace instrumentation
+} // namespace base_conversion
+} // namespace evqovv
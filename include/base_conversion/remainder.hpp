@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "buffer.hpp"
+#include "details.hpp"
+#include "validation.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+namespace details {
+// Digits folded into the remainder per step: the most whose place value
+// still fits in 64 bits.
+inline constexpr auto remainder_step_digits(base radix) noexcept
+    -> std::size_t {
+    switch (radix) {
+    case base::binary:
+        return 64;
+    case base::octal:
+        return 21;
+    case base::decimal:
+        return 19;
+    case base::hexadecimal:
+        break;
+    }
+    return 16;
+}
+
+inline auto throw_zero_modulus_error() -> void {
+    EVQOVV_BASE_CONVERSION_ERROR(other);
+    throw std::invalid_argument("base conversion error: modulus is zero");
+}
+} // namespace details
+
+// Reduces numbers of any length modulo a fixed 64-bit modulus without
+// converting them. Each step folds a whole 64-bit group of digits into the
+// running remainder, r = (r * radix^k + group) mod m, and reduces the
+// 128-bit intermediate with a precomputed Barrett reciprocal instead of a
+// division.
+class modular_reducer {
+public:
+    explicit modular_reducer(std::uint64_t modulus) : modulus_(modulus) {
+        if (modulus == 0) {
+            details::throw_zero_modulus_error();
+        }
+        reciprocal_ = ~u128{} / modulus;
+    }
+
+    auto modulus() const noexcept -> std::uint64_t { return modulus_; }
+
+    auto remainder(base radix, std::string_view str) const -> std::uint64_t {
+        details::validate_string(str);
+
+        auto const &table =
+            details::digit_tables[static_cast<std::size_t>(radix)];
+        auto const multiplier = static_cast<u128>(details::radix_of(radix));
+        auto const step = details::remainder_step_digits(radix);
+        auto const place = power(multiplier, step);
+
+        std::uint64_t result{};
+        for (std::size_t pos{}; pos != str.size();) {
+            auto const count = std::min(step, str.size() - pos);
+            auto group = u128{};
+            for (auto &&ch : str.substr(pos, count)) {
+                auto const digit = table[static_cast<unsigned char>(ch)];
+                if (digit < 0) {
+                    details::throw_invalid_character_error(ch);
+                }
+                group = group * multiplier + static_cast<u128>(digit);
+            }
+            pos += count;
+
+            result = reduce(
+                result * (count == step ? place : power(multiplier, count)) +
+                group);
+        }
+        return result;
+    }
+
+private:
+    using u128 = details::uint128;
+
+    static auto power(u128 value, std::size_t exponent) noexcept -> u128 {
+        u128 result = 1;
+        for (std::size_t i{}; i != exponent; ++i) {
+            result *= value;
+        }
+        return result;
+    }
+
+    // x mod m for x < m * 2^64. The quotient estimate is the high half of
+    // x * floor((2^128 - 1) / m), which is at most 3 short.
+    auto reduce(u128 x) const noexcept -> std::uint64_t {
+        constexpr u128 low_mask = ~std::uint64_t{};
+
+        auto const x0 = x & low_mask;
+        auto const x1 = x >> 64;
+        auto const r0 = reciprocal_ & low_mask;
+        auto const r1 = reciprocal_ >> 64;
+
+        auto const middle = ((x0 * r0) >> 64) + ((x0 * r1) & low_mask) +
+                            ((x1 * r0) & low_mask);
+        auto const quotient =
+            x1 * r1 + ((x0 * r1) >> 64) + ((x1 * r0) >> 64) + (middle >> 64);
+
+        auto result = x - quotient * modulus_;
+        while (result >= modulus_) {
+            result -= modulus_;
+        }
+        return static_cast<std::uint64_t>(result);
+    }
+
+    std::uint64_t modulus_;
+    u128 reciprocal_{};
+};
+
+// `str` read in `radix`, modulo `modulus`, for inputs of any length.
+inline auto remainder(base radix, std::string_view str, std::uint64_t modulus)
+    -> std::uint64_t {
+    return modular_reducer(modulus).remainder(radix, str);
+}
+
+// remainder() of every string against one modulus, sharing the reciprocal.
+inline auto remainders(base radix, std::span<std::string_view const> strs,
+                       std::uint64_t modulus) -> std::vector<std::uint64_t> {
+    modular_reducer const reducer(modulus);
+
+    std::vector<std::uint64_t> result;
+    result.reserve(strs.size());
+    for (auto &&str : strs) {
+        result.push_back(reducer.remainder(radix, str));
+    }
+    return result;
+}
+} // namespace base_conversion
+} // namespace evqovv
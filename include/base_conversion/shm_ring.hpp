@@ -0,0 +1,543 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <format>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../base_conversion.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+namespace shm {
+enum class status : std::uint32_t {
+    ok,
+    invalid_argument,
+    overflow,
+    too_large,
+};
+
+namespace details {
+inline constexpr std::uint64_t segment_magic = 0x6576716f76726e67u;
+inline constexpr std::size_t cache_line = 64;
+
+// A slot at ring position p moves through sequence values
+//   p     free, a client may claim it
+//   p + 1 request written, waiting for the worker
+//   p + 3 taken by the worker
+//   p + 2 result written in place, waiting for the client
+//   p + N released for the next lap (N = slot count, at least 4)
+// A slot may also go from p or p + 1 straight to p + N when its client
+// died before publishing or withdrew a request no worker was serving, and
+// from p + 3 when the worker serving it died.
+struct alignas(cache_line) slot_header {
+    std::atomic<std::uint32_t> sequence;
+    // Number of clients parked on `sequence`.
+    std::atomic<std::uint32_t> client_waiting;
+    // Process id of the client holding the slot in the low half and the
+    // sequence it claimed the slot at in the high half, 0 while it is free.
+    std::atomic<std::uint64_t> owner;
+    base from;
+    base to;
+    std::uint32_t size;
+    status result;
+};
+
+struct alignas(cache_line) segment_header {
+    std::uint64_t magic;
+    std::uint32_t slot_count;
+    std::uint32_t slot_bytes;
+    alignas(cache_line) std::atomic<std::uint64_t> tail;
+    alignas(cache_line) std::atomic<std::uint32_t> worker_waiting;
+    // Process id of the serving worker, 0 while none is attached.
+    std::atomic<std::int32_t> worker;
+};
+
+// How long a parked thread sleeps before it re-checks whether the process
+// it waits on is still alive.
+inline constexpr auto liveness_check_interval = std::chrono::milliseconds(100);
+
+// How long a client waits for a worker to attach before it withdraws its
+// request.
+inline constexpr auto worker_grace_period = std::chrono::seconds(1);
+
+inline auto slot_stride(std::uint32_t slot_bytes) noexcept -> std::size_t {
+    return (sizeof(slot_header) + slot_bytes + cache_line - 1) /
+           cache_line * cache_line;
+}
+
+inline auto segment_size(std::uint32_t slot_count,
+                         std::uint32_t slot_bytes) noexcept -> std::size_t {
+    return sizeof(segment_header) +
+           std::size_t{slot_count} * slot_stride(slot_bytes);
+}
+
+inline auto futex_wait(std::atomic<std::uint32_t> &word,
+                       std::uint32_t expected) noexcept -> void {
+    constexpr auto interval =
+        std::chrono::nanoseconds(liveness_check_interval).count();
+    timespec const timeout{interval / 1'000'000'000,
+                           interval % 1'000'000'000};
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT,
+              expected, &timeout, nullptr, 0);
+}
+
+inline auto futex_wake(std::atomic<std::uint32_t> &word) noexcept -> void {
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAKE,
+              INT_MAX, nullptr, nullptr, 0);
+}
+
+inline auto cpu_relax() noexcept -> void {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Spins for a budget that grows while waits keep finishing within it and
+// shrinks when they end up in the kernel, then parks on a futex. Returns
+// once `word` reaches `target`, after one wakeup or after
+// liveness_check_interval, so callers re-check.
+class adaptive_waiter {
+public:
+    auto wait(std::atomic<std::uint32_t> &word, std::uint32_t target,
+              std::atomic<std::uint32_t> &waiting) noexcept -> void {
+        for (std::uint32_t i{}; i != spin_limit_; ++i) {
+            if (word.load(std::memory_order_acquire) == target) {
+                spin_limit_ = std::min(spin_limit_ * 2, max_spin);
+                return;
+            }
+            cpu_relax();
+        }
+
+        spin_limit_ = std::max(spin_limit_ / 2, min_spin);
+        waiting.fetch_add(1, std::memory_order_seq_cst);
+        auto const current = word.load(std::memory_order_seq_cst);
+        if (current != target) {
+            futex_wait(word, current);
+        }
+        waiting.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::uint32_t min_spin = 64;
+    static constexpr std::uint32_t max_spin = 1 << 16;
+
+    std::uint32_t spin_limit_ = 1 << 10;
+};
+
+inline auto local_waiter() noexcept -> adaptive_waiter & {
+    thread_local adaptive_waiter waiter;
+    return waiter;
+}
+
+inline auto publish(std::atomic<std::uint32_t> &word, std::uint32_t value,
+                    std::atomic<std::uint32_t> &waiting) noexcept -> void {
+    word.store(value, std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_seq_cst) != 0) {
+        futex_wake(word);
+    }
+}
+
+inline auto process_alive(std::int32_t pid) noexcept -> bool {
+    return pid > 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+}
+
+inline auto make_owner(std::uint32_t sequence, std::int32_t pid) noexcept
+    -> std::uint64_t {
+    return std::uint64_t{sequence} << 32 | static_cast<std::uint32_t>(pid);
+}
+
+// Whether `owner` claimed its slot at `sequence` and has died since. An
+// owner left over from an earlier lap never counts.
+inline auto owner_died(std::uint64_t owner, std::uint32_t sequence) noexcept
+    -> bool {
+    return owner != 0 && static_cast<std::uint32_t>(owner >> 32) == sequence &&
+           !process_alive(static_cast<std::int32_t>(owner & 0xffffffffu));
+}
+
+// Frees `slot` from `from` to `to` on behalf of a process that is gone.
+// Returns false when the slot moved on in the meantime.
+inline auto recover_slot(slot_header &slot, std::uint32_t from,
+                         std::uint32_t to) noexcept -> bool {
+    auto owner = slot.owner.load(std::memory_order_relaxed);
+    if (!slot.sequence.compare_exchange_strong(from, to,
+                                               std::memory_order_seq_cst)) {
+        return false;
+    }
+    // Left alone if a client has already claimed the slot for its next lap.
+    slot.owner.compare_exchange_strong(owner, 0, std::memory_order_relaxed);
+    futex_wake(slot.sequence);
+    return true;
+}
+
+[[noreturn]] inline auto throw_system_error(char const *what) -> void {
+    throw std::system_error(errno, std::generic_category(),
+                            std::format("base conversion error: {}", what));
+}
+} // namespace details
+
+// A request ring in a POSIX shared-memory segment. Any number of client
+// processes may submit; exactly one worker serves the ring in order.
+//
+// Slots held by a client that died are reclaimed: by the worker when the
+// request was never published, and by the next client on that slot when
+// the result was never collected. A client that dies between claiming a
+// slot and recording its process id, which are a few instructions apart,
+// still stalls the ring. A client whose request no worker has served for
+// worker_grace_period, or whose worker died while converting it, withdraws
+// the request and throws std::runtime_error. Liveness is checked by process
+// id, so all processes must share a PID namespace.
+class ring {
+public:
+    static auto create(std::string const &name, std::uint32_t slot_count = 64,
+                       std::uint32_t slot_bytes = 4096) -> ring {
+        if (slot_count < 4 || !std::has_single_bit(slot_count)) {
+            throw std::invalid_argument("base conversion error: slot count "
+                                        "must be a power of two >= 4");
+        }
+
+        auto const fd =
+            ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            details::throw_system_error("shm_open");
+        }
+
+        auto const size = details::segment_size(slot_count, slot_bytes);
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            details::throw_system_error("ftruncate");
+        }
+
+        auto result = [&] {
+            try {
+                return ring(fd, size);
+            } catch (...) {
+                ::shm_unlink(name.c_str());
+                throw;
+            }
+        }();
+        auto *header = new (result.base_) details::segment_header{};
+        header->slot_count = slot_count;
+        header->slot_bytes = slot_bytes;
+        for (std::uint32_t i{}; i != slot_count; ++i) {
+            new (result.slot(i)) details::slot_header{};
+            result.slot(i)->sequence.store(i, std::memory_order_relaxed);
+        }
+        std::atomic_ref(header->magic).store(details::segment_magic,
+                                             std::memory_order_release);
+        result.name_ = name;
+        return result;
+    }
+
+    static auto attach(std::string const &name) -> ring {
+        auto const fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            details::throw_system_error("shm_open");
+        }
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            details::throw_system_error("fstat");
+        }
+
+        ring result(fd, static_cast<std::size_t>(info.st_size));
+        auto *header = result.header();
+        if (result.size_ < sizeof(details::segment_header) ||
+            std::atomic_ref(header->magic).load(std::memory_order_acquire) !=
+                details::segment_magic ||
+            result.size_ < details::segment_size(header->slot_count,
+                                                 header->slot_bytes)) {
+            throw std::invalid_argument(
+                "base conversion error: not a conversion ring segment");
+        }
+        return result;
+    }
+
+    ring(ring &&other) noexcept
+        : base_(std::exchange(other.base_, nullptr)),
+          size_(std::exchange(other.size_, 0)), name_(std::move(other.name_)) {
+        other.name_.clear();
+    }
+
+    auto operator=(ring &&other) noexcept -> ring & {
+        if (this != &other) {
+            release();
+            base_ = std::exchange(other.base_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            name_ = std::move(other.name_);
+            other.name_.clear();
+        }
+        return *this;
+    }
+
+    ~ring() { release(); }
+
+    auto slot_bytes() const noexcept -> std::size_t {
+        return header()->slot_bytes;
+    }
+
+    // Client side: submit one request and wait for its result. Safe to call
+    // from several threads and processes at once.
+    auto convert(base from, base to, std::string_view input) -> std::string {
+        if (input.size() > slot_bytes()) {
+            throw std::invalid_argument(
+                "base conversion error: input exceeds ring slot size");
+        }
+
+        auto *header = this->header();
+        auto const mask = header->slot_count - 1;
+
+        std::uint64_t position{};
+        details::slot_header *claimed{};
+        while (true) {
+            position = header->tail.load(std::memory_order_relaxed);
+            claimed = slot(static_cast<std::uint32_t>(position & mask));
+            auto const sequence =
+                claimed->sequence.load(std::memory_order_acquire);
+            auto const expected = static_cast<std::uint32_t>(position);
+            if (sequence == expected) {
+                if (header->tail.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (static_cast<std::int32_t>(sequence - expected) < 0) {
+                // Ring is full: wait for the slot to change, then look at
+                // the tail again since another client may win the slot.
+                // A result left behind by a dead client is released here.
+                auto const uncollected = expected - header->slot_count + 2;
+                if (sequence != uncollected ||
+                    !details::owner_died(
+                        claimed->owner.load(std::memory_order_relaxed),
+                        expected - header->slot_count) ||
+                    !details::recover_slot(*claimed, uncollected, expected)) {
+                    details::local_waiter().wait(claimed->sequence, expected,
+                                                 claimed->client_waiting);
+                }
+            }
+        }
+
+        auto const sequence = static_cast<std::uint32_t>(position);
+        claimed->owner.store(
+            details::make_owner(sequence,
+                                static_cast<std::int32_t>(::getpid())),
+            std::memory_order_relaxed);
+        claimed->from = from;
+        claimed->to = to;
+        claimed->size = static_cast<std::uint32_t>(input.size());
+        std::memcpy(data(claimed), input.data(), input.size());
+        details::publish(claimed->sequence, sequence + 1,
+                         header->worker_waiting);
+
+        auto deadline = std::chrono::steady_clock::now() +
+                        details::worker_grace_period;
+        while (true) {
+            auto const current =
+                claimed->sequence.load(std::memory_order_acquire);
+            if (current == sequence + 2) {
+                break;
+            }
+            if (details::process_alive(
+                    header->worker.load(std::memory_order_relaxed))) {
+                deadline = std::chrono::steady_clock::now() +
+                           details::worker_grace_period;
+            } else if ((current == sequence + 1 || current == sequence + 3) &&
+                       std::chrono::steady_clock::now() >= deadline &&
+                       details::recover_slot(*claimed, current,
+                                             sequence + header->slot_count)) {
+                throw std::runtime_error(
+                    current == sequence + 1
+                        ? "base conversion error: no worker is serving the "
+                          "ring"
+                        : "base conversion error: the worker died while "
+                          "serving the request");
+            }
+            details::local_waiter().wait(claimed->sequence, sequence + 2,
+                                         claimed->client_waiting);
+        }
+
+        auto const result = claimed->result;
+        std::string value(data(claimed), claimed->size);
+        claimed->owner.store(0, std::memory_order_relaxed);
+        details::publish(claimed->sequence, sequence + header->slot_count,
+                         claimed->client_waiting);
+
+        switch (result) {
+        case status::ok:
+            return value;
+        case status::overflow:
+            throw std::overflow_error(value);
+        case status::too_large:
+            throw std::length_error(value);
+        case status::invalid_argument:
+            break;
+        }
+        throw std::invalid_argument(value);
+    }
+
+    // Worker side: serve requests in ring order until `stop` becomes true.
+    // `stop` is only checked between requests, so wake the worker with
+    // wake_worker() after setting it.
+    auto serve(std::atomic<bool> const &stop) -> void {
+        auto *header = this->header();
+        auto const mask = header->slot_count - 1;
+        details::adaptive_waiter waiter;
+
+        header->worker.store(static_cast<std::int32_t>(::getpid()),
+                             std::memory_order_relaxed);
+        for (std::uint64_t head{}; !stop.load(std::memory_order_relaxed);) {
+            auto *current = slot(static_cast<std::uint32_t>(head & mask));
+            auto const claimed = static_cast<std::uint32_t>(head);
+            auto const ready = claimed + 1;
+            auto sequence = current->sequence.load(std::memory_order_acquire);
+
+            if (sequence == claimed + header->slot_count) {
+                // Withdrawn, or reclaimed from a dead client.
+                ++head;
+                continue;
+            }
+            if (sequence == claimed &&
+                header->tail.load(std::memory_order_relaxed) > head) {
+                if (details::owner_died(
+                        current->owner.load(std::memory_order_relaxed),
+                        claimed) &&
+                    details::recover_slot(*current, claimed,
+                                          claimed + header->slot_count)) {
+                    ++head;
+                    continue;
+                }
+            }
+            if (sequence != ready) {
+                waiter.wait(current->sequence, ready, header->worker_waiting);
+                continue;
+            }
+            // Taken with a CAS, since the client may be withdrawing it.
+            if (!current->sequence.compare_exchange_strong(
+                    sequence, ready + 2, std::memory_order_acquire)) {
+                continue;
+            }
+
+            process(*current);
+            details::publish(current->sequence, ready + 1,
+                             current->client_waiting);
+            ++head;
+        }
+        header->worker.store(0, std::memory_order_relaxed);
+    }
+
+    auto wake_worker() noexcept -> void {
+        auto *header = this->header();
+        auto const mask = header->slot_count - 1;
+        for (std::uint32_t i{}; i <= mask; ++i) {
+            details::futex_wake(slot(i)->sequence);
+        }
+    }
+
+private:
+    ring(int fd, std::size_t size) : size_(size) {
+        auto *mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            details::throw_system_error("mmap");
+        }
+        base_ = static_cast<char *>(mapped);
+    }
+
+    auto release() noexcept -> void {
+        if (base_ != nullptr) {
+            ::munmap(base_, size_);
+            base_ = nullptr;
+        }
+        if (!name_.empty()) {
+            ::shm_unlink(name_.c_str());
+            name_.clear();
+        }
+    }
+
+    auto header() const noexcept -> details::segment_header * {
+        return reinterpret_cast<details::segment_header *>(base_);
+    }
+
+    auto slot(std::uint32_t index) const noexcept -> details::slot_header * {
+        return reinterpret_cast<details::slot_header *>(
+            base_ + sizeof(details::segment_header) +
+            index * details::slot_stride(header()->slot_bytes));
+    }
+
+    static auto data(details::slot_header *slot) noexcept -> char * {
+        return reinterpret_cast<char *>(slot + 1);
+    }
+
+    // The request comes from another process, so its fields are checked
+    // before they are used.
+    auto process(details::slot_header &request) noexcept -> void {
+        auto const write = [&](status result, std::string_view value) {
+            if (value.size() > slot_bytes()) {
+                result = status::too_large;
+                value = "base conversion error: result exceeds ring slot size";
+            }
+            value = value.substr(0, slot_bytes());
+            std::memcpy(data(&request), value.data(), value.size());
+            request.size = static_cast<std::uint32_t>(value.size());
+            request.result = result;
+        };
+
+        auto const size = request.size;
+        auto const from = static_cast<std::uint32_t>(request.from);
+        auto const to = static_cast<std::uint32_t>(request.to);
+        if (size > slot_bytes()) {
+            write(status::invalid_argument,
+                  "base conversion error: input exceeds ring slot size");
+            return;
+        }
+        if (from > static_cast<std::uint32_t>(base::hexadecimal) ||
+            to > static_cast<std::uint32_t>(base::hexadecimal)) {
+            write(status::invalid_argument,
+                  "base conversion error: invalid base in request");
+            return;
+        }
+
+        try {
+            write(status::ok,
+                  base_conversion::convert(
+                      static_cast<base>(from), static_cast<base>(to),
+                      std::string_view(data(&request), size)));
+        } catch (std::overflow_error const &e) {
+            write(status::overflow, e.what());
+        } catch (std::exception const &e) {
+            write(status::invalid_argument, e.what());
+        }
+    }
+
+    char *base_{};
+    std::size_t size_{};
+    std::string name_;
+};
+} // namespace shm
+} // namespace base_conversion
+} // namespace evqovv
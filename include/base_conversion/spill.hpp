@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../base_conversion.hpp"
+#include "buffer.hpp"
+#include "details.hpp"
+#include "trace.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+struct memory_budget {
+    // Outputs up to this size are returned in memory; larger ones are
+    // streamed to an unnamed temporary file through a buffer of at most
+    // this size.
+    std::size_t memory_bytes = 64 << 20;
+    // Outputs larger than memory_bytes + spill_bytes are rejected before any
+    // work is done.
+    std::size_t spill_bytes = std::numeric_limits<std::size_t>::max();
+    // Where spill files are created; empty uses $TMPDIR, or /var/tmp when it
+    // is unset. Pages written to a tmpfs are charged to the same memory
+    // cgroup as the process, which defeats the budget, so this should name
+    // a disk-backed directory. /tmp is a tmpfs on many distributions.
+    std::string spill_directory;
+};
+
+// The result of convert_with_budget(): either an in-memory string or a
+// read-only mapping of the temporary file it was spilled to.
+class conversion_output {
+public:
+    explicit conversion_output(std::string value) noexcept
+        : value_(std::move(value)) {}
+
+    conversion_output(int fd, std::size_t size) : fd_(fd), size_(size) {
+        mapping_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+        if (mapping_ == MAP_FAILED) {
+            auto const error = errno;
+            ::close(fd_);
+            throw std::system_error(error, std::system_category(),
+                                    "base conversion error: mmap");
+        }
+    }
+
+    conversion_output(conversion_output &&other) noexcept
+        : value_(std::move(other.value_)),
+          fd_(std::exchange(other.fd_, -1)),
+          size_(std::exchange(other.size_, 0)),
+          mapping_(std::exchange(other.mapping_, nullptr)) {}
+
+    auto operator=(conversion_output &&other) noexcept -> conversion_output & {
+        if (this != &other) {
+            release();
+            value_ = std::move(other.value_);
+            fd_ = std::exchange(other.fd_, -1);
+            size_ = std::exchange(other.size_, 0);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+        }
+        return *this;
+    }
+
+    ~conversion_output() { release(); }
+
+    auto spilled() const noexcept -> bool { return fd_ >= 0; }
+
+    auto view() const noexcept -> std::string_view {
+        return spilled() ? std::string_view(static_cast<char const *>(mapping_),
+                                            size_)
+                         : std::string_view(value_);
+    }
+
+    // The temporary file, or -1 when the output is in memory.
+    auto native_handle() const noexcept -> int { return fd_; }
+
+private:
+    auto release() noexcept -> void {
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    std::string value_;
+    int fd_{-1};
+    std::size_t size_{};
+    void *mapping_{};
+};
+
+namespace details {
+[[noreturn]] inline auto throw_spill_error(char const *what) -> void {
+    throw std::system_error(errno, std::system_category(),
+                            std::string("base conversion error: ") + what);
+}
+
+// The directory spill files are created in.
+inline auto spill_directory(memory_budget const &budget) -> std::string {
+    if (!budget.spill_directory.empty()) {
+        return budget.spill_directory;
+    }
+    if (auto const *tmpdir = std::getenv("TMPDIR");
+        tmpdir != nullptr && *tmpdir != '\0') {
+        return tmpdir;
+    }
+    return "/var/tmp";
+}
+
+// Unnamed when the filesystem supports O_TMPFILE, otherwise created and
+// unlinked straight away.
+inline auto open_spill_file(std::string const &directory) -> int {
+    auto fd = ::open(directory.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+    if (fd >= 0) {
+        return fd;
+    }
+    if (errno != EOPNOTSUPP && errno != EISDIR && errno != EINVAL) {
+        details::throw_spill_error("open spill file");
+    }
+
+    auto path = directory + "/base_conversion.XXXXXX";
+    fd = ::mkostemp(path.data(), O_CLOEXEC);
+    if (fd < 0) {
+        details::throw_spill_error("create spill file");
+    }
+    ::unlink(path.c_str());
+    return fd;
+}
+
+class spill_writer {
+public:
+    spill_writer(int fd, std::size_t buffer_size)
+        : fd_(fd), buffer_(buffer_size, '\0') {}
+
+    auto put(char ch) -> void {
+        buffer_[used_++] = ch;
+        if (used_ == buffer_.size()) {
+            flush();
+        }
+    }
+
+    auto flush() -> void {
+        EVQOVV_BASE_CONVERSION_SPAN("spill_write", used_);
+        std::string_view pending(buffer_.data(), used_);
+        while (!pending.empty()) {
+            auto const n = ::write(fd_, pending.data(), pending.size());
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                details::throw_spill_error("write spill file");
+            }
+            pending.remove_prefix(static_cast<std::size_t>(n));
+        }
+        used_ = 0;
+    }
+
+private:
+    int fd_;
+    std::string buffer_;
+    std::size_t used_{};
+};
+
+inline auto validate_digits(base radix, std::string_view str) -> void {
+    for (auto &&ch : str) {
+        if (details::digit_value(radix, ch) < 0) {
+            details::throw_invalid_character_error(ch);
+        }
+    }
+}
+} // namespace details
+
+// convert() bounded by `budget`. The output size of power-of-two conversions
+// is known once the input is validated, so a job that cannot fit in memory
+// plus spill space throws std::length_error before anything is allocated.
+// Conversions to or from decimal are limited to uint64_t and always fit.
+inline auto convert_with_budget(base from, base to, std::string_view str,
+                                memory_budget const &budget = {})
+    -> conversion_output {
+    if (from == base::decimal || to == base::decimal) {
+        return conversion_output(base_conversion::convert(from, to, str));
+    }
+
+    details::validate_string(str);
+    details::validate_digits(from, str);
+
+    auto const digits = details::trim_leading_zeros(str);
+    auto const size =
+        from == to ? digits.size() : details::regrouped_size(from, to, digits);
+    if (size > budget.memory_bytes &&
+        size - budget.memory_bytes > budget.spill_bytes) {
+        throw std::length_error("base conversion error: output exceeds the "
+                                "memory budget");
+    }
+
+    // Same-base output is uppercased, like convert()'s.
+    auto const same_base_digit = [&](char ch) {
+        return details::decimal_to_hexadecimal_map(
+            details::digit_value(from, ch));
+    };
+
+    if (size <= budget.memory_bytes) {
+        if (from == to) {
+            std::string result(digits);
+            std::ranges::transform(result, result.begin(), same_base_digit);
+            return conversion_output(std::move(result));
+        }
+
+        std::string result(size, '\0');
+        details::regroup(from, to, digits, result);
+        return conversion_output(std::move(result));
+    }
+
+    auto const fd = details::open_spill_file(details::spill_directory(budget));
+    try {
+        details::spill_writer writer(
+            fd, std::clamp<std::size_t>(budget.memory_bytes, 1, 1 << 20));
+        if (from == to) {
+            for (auto &&ch : digits) {
+                writer.put(same_base_digit(ch));
+            }
+        } else {
+            details::regroup_each(from, to, digits, size,
+                                  [&](char ch) { writer.put(ch); });
+        }
+        writer.flush();
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    return conversion_output(fd, size);
+}
+} // namespace base_conversion
+} // namespace evqovv
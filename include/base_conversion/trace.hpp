@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Timeline of the phases of parallel and spilling conversions, exported as
+// Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev). Spans are
+// compiled in with EVQOVV_BASE_CONVERSION_ENABLE_TRACE and recorded only
+// between trace::start() and trace::stop().
+#ifdef EVQOVV_BASE_CONVERSION_ENABLE_TRACE
+#define EVQOVV_BASE_CONVERSION_SPAN_NAME_(line)                                \
+    evqovv_base_conversion_span_##line
+#define EVQOVV_BASE_CONVERSION_SPAN_NAME(line)                                 \
+    EVQOVV_BASE_CONVERSION_SPAN_NAME_(line)
+#define EVQOVV_BASE_CONVERSION_SPAN(name, arg)                                 \
+    ::evqovv::base_conversion::trace::details::span                            \
+        EVQOVV_BASE_CONVERSION_SPAN_NAME(__LINE__)(name, arg)
+#else
+#define EVQOVV_BASE_CONVERSION_SPAN(name, arg)
+#endif
+
+namespace evqovv {
+namespace base_conversion {
+namespace trace {
+namespace details {
+struct event {
+    char const *name;
+    std::uint64_t begin_ns;
+    std::uint64_t end_ns;
+    std::uint64_t arg;
+};
+
+// Written only by its owning thread. Events are published by a release
+// store of `size`, so export never takes a lock on the recording path.
+struct thread_buffer {
+    explicit thread_buffer(std::size_t capacity, std::uint32_t id)
+        : events(std::make_unique<event[]>(capacity)), capacity(capacity),
+          tid(id) {}
+
+    std::unique_ptr<event[]> events;
+    std::size_t capacity;
+    std::uint32_t tid;
+    std::atomic<std::size_t> size{};
+    std::atomic<std::size_t> dropped{};
+};
+
+inline std::atomic<bool> recording{};
+inline std::atomic<std::size_t> buffer_capacity{std::size_t{1} << 16};
+
+class registry {
+public:
+    auto attach() -> std::shared_ptr<thread_buffer> {
+        std::lock_guard lock(mutex_);
+        auto buffer = std::make_shared<thread_buffer>(
+            buffer_capacity.load(std::memory_order_relaxed), next_tid_++);
+        buffers_.push_back(buffer);
+        return buffer;
+    }
+
+    auto buffers() const -> std::vector<std::shared_ptr<thread_buffer>> {
+        std::lock_guard lock(mutex_);
+        return buffers_;
+    }
+
+    // Buffers of threads that have exited are dropped, the rest emptied.
+    auto clear() -> void {
+        std::lock_guard lock(mutex_);
+        std::erase_if(buffers_, [](auto const &buffer) {
+            return buffer.use_count() == 1;
+        });
+        for (auto const &buffer : buffers_) {
+            buffer->size.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<thread_buffer>> buffers_;
+    std::uint32_t next_tid_{1};
+};
+
+inline auto global_registry() -> registry & {
+    static registry instance;
+    return instance;
+}
+
+inline auto local_buffer() -> thread_buffer & {
+    thread_local auto const buffer = global_registry().attach();
+    return *buffer;
+}
+
+inline auto now_ns() noexcept -> std::uint64_t {
+    static auto const origin = std::chrono::steady_clock::now();
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - origin)
+            .count());
+}
+
+// Records [construction, destruction) on the current thread. `name` must
+// outlive the trace; string literals are expected.
+class span {
+public:
+    span(char const *name, std::uint64_t arg) noexcept
+        : name_(recording.load(std::memory_order_relaxed) ? name : nullptr),
+          arg_(arg), begin_ns_(name_ ? now_ns() : 0) {}
+
+    span(span const &) = delete;
+    auto operator=(span const &) -> span & = delete;
+
+    ~span() {
+        if (name_ == nullptr) {
+            return;
+        }
+
+        auto &buffer = local_buffer();
+        auto const size = buffer.size.load(std::memory_order_relaxed);
+        if (size == buffer.capacity) {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.events[size] = {name_, begin_ns_, now_ns(), arg_};
+        buffer.size.store(size + 1, std::memory_order_release);
+    }
+
+private:
+    char const *name_;
+    std::uint64_t arg_;
+    std::uint64_t begin_ns_;
+};
+} // namespace details
+
+// Events kept per thread; threads that exceed it count the excess as
+// dropped. Applies to threads that record their first span afterwards.
+inline auto set_buffer_capacity(std::size_t events) noexcept -> void {
+    details::buffer_capacity.store(std::max<std::size_t>(events, 1),
+                                   std::memory_order_relaxed);
+}
+
+inline auto start() noexcept -> void {
+    details::recording.store(true, std::memory_order_relaxed);
+}
+
+inline auto stop() noexcept -> void {
+    details::recording.store(false, std::memory_order_relaxed);
+}
+
+// Discards everything recorded so far. Call only while no conversion is
+// running.
+inline auto clear() -> void { details::global_registry().clear(); }
+
+// Complete ("X") events in microseconds, one trace thread per recording
+// thread. Spans still open are not included.
+inline auto to_chrome_json() -> std::string {
+    std::string result = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    auto first = true;
+    for (auto const &buffer : details::global_registry().buffers()) {
+        auto const size = buffer->size.load(std::memory_order_acquire);
+        auto const dropped = buffer->dropped.load(std::memory_order_relaxed);
+        result += std::format(
+            "{}{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,"
+            "\"tid\":{},\"args\":{{\"name\":\"thread {}\",\"dropped\":{}}}}}",
+            first ? "" : ",", buffer->tid, buffer->tid, dropped);
+        first = false;
+
+        for (std::size_t i{}; i != size; ++i) {
+            auto const &e = buffer->events[i];
+            result += std::format(
+                ",{{\"ph\":\"X\",\"cat\":\"base_conversion\",\"name\":\"{}\","
+                "\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f},"
+                "\"args\":{{\"value\":{}}}}}",
+                e.name, buffer->tid, static_cast<double>(e.begin_ns) / 1e3,
+                static_cast<double>(e.end_ns - e.begin_ns) / 1e3, e.arg);
+        }
+    }
+    result += "]}\n";
+    return result;
+}
+} // namespace trace
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "function_id.hpp"
+
+// USDT probes under the "evqovv_base_conversion" provider:
+//
+//   conversion__entry(function id, function name, input length)
+//   conversion__exit(function id, input length, outcome, output length)
+//   conversion__error(function id, input length, error kind)
+//
+// Function ids and error kinds follow instrumentation::function_id and
+// instrumentation::error_kind; an exit outcome of 0 is success and k + 1
+// means the call failed with error kind k. For example:
+//
+//   bpftrace -e 'usdt:./app:evqovv_base_conversion:conversion__entry
+//                /arg2 > 1048576/ { @[str(arg1)] = hist(arg2); }'
+//
+// Without <sys/sdt.h> the probes compile to nothing.
+//
+// Each probe also has a semaphore, <provider>_<probe>_semaphore, that
+// tracers raise while attached. This header never turns semaphores on, as
+// _SDT_HAS_SEMAPHORES applies to every provider in the translation unit.
+// A program that defines it for all of its units, e.g. on the command
+// line, gets probes that skip the arguments and the outcome bookkeeping
+// while no tracer is attached; otherwise the probes fire unconditionally.
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define EVQOVV_BASE_CONVERSION_USDT3(name, a, b, c)                            \
+    DTRACE_PROBE3(evqovv_base_conversion, name, a, b, c)
+#define EVQOVV_BASE_CONVERSION_USDT4(name, a, b, c, d)                         \
+    DTRACE_PROBE4(evqovv_base_conversion, name, a, b, c, d)
+
+// Defined either way, so that units with semaphores on always link.
+inline unsigned short evqovv_base_conversion_conversion__entry_semaphore
+    __attribute__((unused, section(".probes")));
+inline unsigned short evqovv_base_conversion_conversion__exit_semaphore
+    __attribute__((unused, section(".probes")));
+inline unsigned short evqovv_base_conversion_conversion__error_semaphore
+    __attribute__((unused, section(".probes")));
+
+#ifdef _SDT_HAS_SEMAPHORES
+#define EVQOVV_BASE_CONVERSION_USDT_ENABLED(name)                              \
+    (*static_cast<unsigned short const volatile *>(                            \
+         &::evqovv_base_conversion_##name##_semaphore) != 0)
+#else
+#define EVQOVV_BASE_CONVERSION_USDT_ENABLED(name) true
+#endif
+#else
+#define EVQOVV_BASE_CONVERSION_USDT3(name, a, b, c)
+#define EVQOVV_BASE_CONVERSION_USDT4(name, a, b, c, d)
+#define EVQOVV_BASE_CONVERSION_USDT_ENABLED(name) false
+#endif
+
+namespace evqovv {
+namespace base_conversion {
+namespace tracepoints {
+namespace details {
+using instrumentation::error_kind;
+using instrumentation::function_id;
+
+// Whether any tracer is attached to the probes.
+inline auto enabled() noexcept -> bool {
+    return EVQOVV_BASE_CONVERSION_USDT_ENABLED(conversion__entry) ||
+           EVQOVV_BASE_CONVERSION_USDT_ENABLED(conversion__exit) ||
+           EVQOVV_BASE_CONVERSION_USDT_ENABLED(conversion__error);
+}
+
+inline auto fire_entry([[maybe_unused]] function_id id,
+                       [[maybe_unused]] std::size_t input_size) noexcept
+    -> void {
+    EVQOVV_BASE_CONVERSION_USDT3(
+        conversion__entry, static_cast<unsigned>(id),
+        instrumentation::function_name(id).data(),
+        static_cast<std::uint64_t>(input_size));
+}
+
+inline auto fire_exit([[maybe_unused]] function_id id,
+                      [[maybe_unused]] std::size_t input_size,
+                      [[maybe_unused]] unsigned outcome,
+                      [[maybe_unused]] std::size_t output_size) noexcept
+    -> void {
+    EVQOVV_BASE_CONVERSION_USDT4(conversion__exit, static_cast<unsigned>(id),
+                                 static_cast<std::uint64_t>(input_size),
+                                 outcome,
+                                 static_cast<std::uint64_t>(output_size));
+}
+
+inline auto fire_error([[maybe_unused]] function_id id,
+                       [[maybe_unused]] std::size_t input_size,
+                       [[maybe_unused]] error_kind kind) noexcept -> void {
+    EVQOVV_BASE_CONVERSION_USDT3(
+        conversion__error, static_cast<unsigned>(id),
+        static_cast<std::uint64_t>(input_size), static_cast<unsigned>(kind));
+}
+} // namespace details
+} // namespace tracepoints
+} // namespace base_conversion
+} // namespace evqovv
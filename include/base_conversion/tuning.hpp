@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace evqovv {
+namespace base_conversion {
+namespace tuning {
+// Input lengths at which the dispatcher switches implementation. The
+// defaults are used until a calibration or a profile is applied.
+struct thresholds {
+    // hexadecimal_to_octal / octal_to_hexadecimal stop going through an
+    // intermediate binary string and regroup bits directly.
+    std::size_t direct_transcode_min_length = 1;
+    // convert_parallel() splits the work across threads.
+    std::size_t parallel_min_length = std::size_t{1} << 20;
+};
+
+namespace details {
+inline std::atomic<std::size_t> direct_transcode_min_length{
+    thresholds{}.direct_transcode_min_length};
+inline std::atomic<std::size_t> parallel_min_length{
+    thresholds{}.parallel_min_length};
+} // namespace details
+
+inline auto current() noexcept -> thresholds {
+    thresholds result;
+    result.direct_transcode_min_length =
+        details::direct_transcode_min_length.load(std::memory_order_relaxed);
+    result.parallel_min_length =
+        details::parallel_min_length.load(std::memory_order_relaxed);
+    return result;
+}
+
+inline auto apply(thresholds const &values) noexcept -> void {
+    details::direct_transcode_min_length.store(
+        values.direct_transcode_min_length, std::memory_order_relaxed);
+    details::parallel_min_length.store(values.parallel_min_length,
+                                       std::memory_order_relaxed);
+}
+} // namespace tuning
+} // namespace base_conversion
+} // namespace evqovv
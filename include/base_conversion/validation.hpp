@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "../base_conversion.hpp"
+#include "buffer.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+struct validation_result {
+    // ok, empty_string or invalid_character.
+    conversion_errc ec{};
+    // Offset of the first invalid character across everything fed so far.
+    std::size_t error_offset{};
+    // Length of the input after trim_leading_zeros(), so "000" counts as 1.
+    std::size_t significant_digits{};
+    bool fits_uint64{};
+    bool fits_uint128{};
+};
+
+namespace details {
+inline constexpr auto make_digit_table(base radix) noexcept
+    -> std::array<signed char, 256> {
+    std::array<signed char, 256> table{};
+    for (std::size_t ch{}; ch != table.size(); ++ch) {
+        table[ch] = static_cast<signed char>(
+            digit_value(radix, static_cast<char>(ch)));
+    }
+    return table;
+}
+
+inline constexpr std::array<std::array<signed char, 256>, 4> digit_tables{
+    make_digit_table(base::binary), make_digit_table(base::octal),
+    make_digit_table(base::decimal), make_digit_table(base::hexadecimal)};
+
+// Binary and octal digits are '0' plus the low 1 or 3 bits, so eight of
+// them can be checked with a single mask and compare.
+inline constexpr auto swar_class_mask(base radix) noexcept -> std::uint64_t {
+    switch (radix) {
+    case base::binary:
+        return 0xfefefefefefefefeu;
+    case base::octal:
+        return 0xf8f8f8f8f8f8f8f8u;
+    case base::decimal:
+    case base::hexadecimal:
+        break;
+    }
+    return 0;
+}
+
+inline constexpr std::string_view uint128_max_decimal =
+    "340282366920938463463374607431768211455";
+inline constexpr std::string_view uint64_max_decimal = "18446744073709551615";
+} // namespace details
+
+// Checks a number delivered in pieces without converting it. Once an invalid
+// character has been seen further input is ignored.
+class validator {
+public:
+    explicit validator(base radix) noexcept
+        : radix_(radix),
+          table_(&details::digit_tables[static_cast<std::size_t>(radix)]),
+          mask_(details::swar_class_mask(radix)) {}
+
+    // Returns false once the input is known to be invalid.
+    auto feed(std::string_view chunk) noexcept -> bool {
+        if (invalid_) {
+            return false;
+        }
+
+        auto const *data = chunk.data();
+        auto const size = chunk.size();
+        std::size_t i{};
+
+        if (leading_ == 0) {
+            while (i + 8 <= size &&
+                   details::load_word(data + i) == details::zero_digits) {
+                i += 8;
+            }
+            while (i != size && data[i] == '0') {
+                ++i;
+            }
+            if (i == size) {
+                offset_ += size;
+                return true;
+            }
+
+            auto const digit = (*table_)[static_cast<unsigned char>(data[i])];
+            if (digit < 0) {
+                return fail(i);
+            }
+            leading_ = static_cast<unsigned>(digit);
+            remember(data[i]);
+            ++significant_;
+            ++i;
+        }
+
+        auto const start = i;
+        if (mask_ != 0) {
+            while (i + 8 <= size && (details::load_word(data + i) & mask_) ==
+                                        details::zero_digits) {
+                i += 8;
+            }
+        } else {
+            // Invalid characters map to -1, so OR-ing eight lookups leaves
+            // the sign bit set if any of them is invalid.
+            auto const &table = *table_;
+            auto const *bytes = reinterpret_cast<unsigned char const *>(data);
+            while (i + 8 <= size &&
+                   (table[bytes[i]] | table[bytes[i + 1]] |
+                    table[bytes[i + 2]] | table[bytes[i + 3]] |
+                    table[bytes[i + 4]] | table[bytes[i + 5]] |
+                    table[bytes[i + 6]] | table[bytes[i + 7]]) >= 0) {
+                i += 8;
+            }
+        }
+        for (; i != size; ++i) {
+            if ((*table_)[static_cast<unsigned char>(data[i])] < 0) {
+                break;
+            }
+        }
+
+        remember(chunk.substr(start, i - start));
+        significant_ += i - start;
+        if (i != size) {
+            return fail(i);
+        }
+        offset_ += size;
+        return true;
+    }
+
+    auto finish() const noexcept -> validation_result {
+        validation_result result;
+        if (invalid_) {
+            result.ec = conversion_errc::invalid_character;
+            result.error_offset = error_offset_;
+            return result;
+        }
+        if (offset_ == 0) {
+            result.ec = conversion_errc::empty_string;
+            return result;
+        }
+
+        result.significant_digits = std::max<std::size_t>(significant_, 1);
+        if (radix_ == base::decimal) {
+            auto const digits = std::string_view(prefix_.data(), prefix_size_);
+            result.fits_uint64 = fits(digits, details::uint64_max_decimal);
+            result.fits_uint128 = fits(digits, details::uint128_max_decimal);
+        } else {
+            auto const bits =
+                significant_ == 0
+                    ? std::size_t{0}
+                    : (significant_ - 1) *
+                              static_cast<std::size_t>(
+                                  details::bits_per_digit(radix_)) +
+                          static_cast<std::size_t>(std::bit_width(leading_));
+            result.fits_uint64 = bits <= 64;
+            result.fits_uint128 = bits <= 128;
+        }
+        return result;
+    }
+
+private:
+    auto fail(std::size_t index) noexcept -> bool {
+        invalid_ = true;
+        error_offset_ = offset_ + index;
+        return false;
+    }
+
+    // Decimal keeps just enough leading digits to compare against the
+    // largest uint128_t.
+    auto remember(std::string_view digits) noexcept -> void {
+        if (radix_ != base::decimal) {
+            return;
+        }
+        auto const count =
+            std::min(digits.size(), prefix_.size() - prefix_size_);
+        std::copy_n(digits.data(), count, prefix_.data() + prefix_size_);
+        prefix_size_ += count;
+        overflowed_prefix_ = overflowed_prefix_ || count != digits.size();
+    }
+
+    auto remember(char digit) noexcept -> void {
+        remember(std::string_view(&digit, 1));
+    }
+
+    auto fits(std::string_view digits, std::string_view max) const noexcept
+        -> bool {
+        if (overflowed_prefix_ || digits.size() != max.size()) {
+            return !overflowed_prefix_ && digits.size() < max.size();
+        }
+        return digits <= max;
+    }
+
+    base radix_;
+    std::array<signed char, 256> const *table_;
+    std::uint64_t mask_;
+    std::size_t offset_{};
+    std::size_t significant_{};
+    unsigned leading_{};
+    bool invalid_{};
+    std::size_t error_offset_{};
+    std::array<char, details::uint128_max_decimal.size() + 1> prefix_{};
+    std::size_t prefix_size_{};
+    bool overflowed_prefix_{};
+};
+
+// One-shot form of validator for a payload that is already in memory.
+inline auto validate(base radix, std::string_view str) noexcept
+    -> validation_result {
+    validator checker(radix);
+    checker.feed(str);
+    return checker.finish();
+}
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "buffer.hpp"
+#include "details.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+namespace details {
+inline constexpr std::size_t max_varint_size = 10;
+
+// 1 to 10 bytes, computed without a loop.
+inline constexpr auto varint_size(std::uint64_t value) noexcept
+    -> std::size_t {
+    return (static_cast<std::size_t>(std::bit_width(value | 1)) * 9 + 64) /
+           64;
+}
+
+inline auto write_varint(std::uint64_t value, std::uint8_t *out) noexcept
+    -> std::uint8_t * {
+    while (value >= 0x80) {
+        *out++ = static_cast<std::uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<std::uint8_t>(value);
+    return out;
+}
+
+// Reads one varint from the front of `data` and drops it from `data`.
+inline auto read_varint(std::span<std::uint8_t const> &data)
+    -> std::uint64_t {
+    std::uint64_t value{};
+    for (std::size_t i{}; i != data.size() && i != max_varint_size; ++i) {
+        auto const byte = static_cast<std::uint64_t>(data[i]);
+        // The tenth byte holds bit 63 only.
+        if (i == max_varint_size - 1 && byte > 1) {
+            break;
+        }
+        value |= (byte & 0x7f) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            data = data.subspan(i + 1);
+            return value;
+        }
+    }
+    throw std::invalid_argument(
+        "base conversion error: truncated or overlong varint");
+}
+
+inline auto parse_varint_text(base from, std::string_view str)
+    -> std::uint64_t {
+    auto const digits = trim_leading_zeros(str);
+    for (auto &&ch : digits) {
+        if (digit_value(from, ch) < 0) {
+            throw_invalid_character_error(ch);
+        }
+    }
+
+    std::uint64_t value{};
+    if (parse_uint64(from, digits, value) != conversion_errc::ok) {
+        throw_overflow_error();
+    }
+    return value;
+}
+
+// Decimal may carry a leading '-' and must fit in int64_t; other bases are
+// read as two's complement.
+inline auto parse_zigzag_text(base from, std::string_view str)
+    -> std::uint64_t {
+    validate_string(str);
+
+    auto const negative = from == base::decimal && str.front() == '-';
+    if (negative) {
+        validate_string(str.substr(1));
+    }
+    auto const magnitude =
+        parse_varint_text(from, negative ? str.substr(1) : str);
+    auto const limit = (std::uint64_t{1} << 63) - (negative ? 0 : 1);
+    if (from == base::decimal && magnitude > limit) {
+        throw_overflow_error();
+    }
+
+    auto const value = static_cast<std::int64_t>(negative ? 0 - magnitude
+                                                          : magnitude);
+    return (static_cast<std::uint64_t>(value) << 1) ^
+           static_cast<std::uint64_t>(value >> 63);
+}
+
+inline auto format_varint_text(base to, std::uint64_t value)
+    -> std::string {
+    char digits[64];
+    auto const [ec, size] = format_uint64(to, value, digits);
+    return {digits, size};
+}
+
+inline auto format_zigzag_text(base to, std::uint64_t encoded)
+    -> std::string {
+    auto const value = (encoded >> 1) ^ (0 - (encoded & 1));
+    if (to == base::decimal) {
+        return std::to_string(static_cast<std::int64_t>(value));
+    }
+    return format_varint_text(to, value);
+}
+
+template <typename Parse>
+auto encode_varints(std::span<std::string_view const> strs, Parse parse)
+    -> std::vector<std::uint8_t> {
+    std::vector<std::uint64_t> values(strs.size());
+    for (std::size_t i{}; i != strs.size(); ++i) {
+        values[i] = parse(strs[i]);
+    }
+
+    std::size_t size{};
+    for (auto &&value : values) {
+        size += varint_size(value);
+    }
+
+    std::vector<std::uint8_t> result(size);
+    auto *out = result.data();
+    for (auto &&value : values) {
+        out = write_varint(value, out);
+    }
+    return result;
+}
+} // namespace details
+
+// Appends the LEB128 (protobuf varint) encoding of the unsigned 64-bit
+// number `str`, written in `from`, to `out`.
+inline auto append_varint(base from, std::string_view str,
+                          std::vector<std::uint8_t> &out) -> void {
+    details::validate_string(str);
+    auto const value = details::parse_varint_text(from, str);
+
+    auto const size = out.size();
+    out.resize(size + details::varint_size(value));
+    details::write_varint(value, out.data() + size);
+}
+
+// As append_varint() for a signed 64-bit number, zigzag encoded like
+// protobuf's sint64. Decimal input may start with '-'.
+inline auto append_zigzag_varint(base from, std::string_view str,
+                                 std::vector<std::uint8_t> &out) -> void {
+    auto const value = details::parse_zigzag_text(from, str);
+
+    auto const size = out.size();
+    out.resize(size + details::varint_size(value));
+    details::write_varint(value, out.data() + size);
+}
+
+// Reads one varint from the front of `data`, drops it from `data` and
+// returns the number written in `to`.
+inline auto read_varint(std::span<std::uint8_t const> &data, base to)
+    -> std::string {
+    return details::format_varint_text(to, details::read_varint(data));
+}
+
+inline auto read_zigzag_varint(std::span<std::uint8_t const> &data, base to)
+    -> std::string {
+    return details::format_zigzag_text(to, details::read_varint(data));
+}
+
+// Every string as consecutive varints. All values are parsed first so that
+// the output is allocated once.
+inline auto encode_varints(base from, std::span<std::string_view const> strs)
+    -> std::vector<std::uint8_t> {
+    return details::encode_varints(strs, [&](std::string_view str) {
+        details::validate_string(str);
+        return details::parse_varint_text(from, str);
+    });
+}
+
+inline auto encode_zigzag_varints(base from,
+                                  std::span<std::string_view const> strs)
+    -> std::vector<std::uint8_t> {
+    return details::encode_varints(strs, [&](std::string_view str) {
+        return details::parse_zigzag_text(from, str);
+    });
+}
+
+// Every varint in `data`, which must end on a varint boundary.
+inline auto decode_varints(std::span<std::uint8_t const> data, base to)
+    -> std::vector<std::string> {
+    std::vector<std::string> result;
+    while (!data.empty()) {
+        result.push_back(read_varint(data, to));
+    }
+    return result;
+}
+
+inline auto decode_zigzag_varints(std::span<std::uint8_t const> data,
+                                  base to) -> std::vector<std::string> {
+    std::vector<std::string> result;
+    while (!data.empty()) {
+        result.push_back(read_zigzag_varint(data, to));
+    }
+    return result;
+}
+} // namespace base_conversion
+} // namespace evqovv
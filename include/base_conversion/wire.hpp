@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "../base_conversion.hpp"
+#include "batch.hpp"
+#include "buffer.hpp"
+
+// Binary protocol of the conversion daemon. All integers are little-endian.
+//
+//   request:  u32 size | u32 id | u8 from | u8 to | input bytes
+//   response: u32 size | u32 id | u8 status | result or error message
+//
+// `size` counts the bytes after itself. Bases use the values of
+// base_conversion::base and status those of base_conversion::batch_status.
+// Clients may pipeline any number of requests on a connection; responses
+// come back in request order and echo the request id. Requests whose result
+// could exceed max_frame_bytes are answered with invalid_argument instead of
+// being converted.
+namespace evqovv {
+namespace base_conversion {
+namespace wire {
+inline constexpr std::size_t size_bytes = 4;
+inline constexpr std::size_t request_header_bytes = 4 + 1 + 1;
+inline constexpr std::size_t response_header_bytes = 4 + 1;
+inline constexpr std::size_t max_frame_bytes = std::size_t{64} << 20;
+
+struct request {
+    std::uint32_t id{};
+    batch_item item{};
+};
+
+inline auto load_u32(char const *data) noexcept -> std::uint32_t {
+    auto const *bytes = reinterpret_cast<unsigned char const *>(data);
+    return static_cast<std::uint32_t>(bytes[0]) |
+           static_cast<std::uint32_t>(bytes[1]) << 8 |
+           static_cast<std::uint32_t>(bytes[2]) << 16 |
+           static_cast<std::uint32_t>(bytes[3]) << 24;
+}
+
+inline auto append_u32(std::string &out, std::uint32_t value) -> void {
+    for (auto shift = 0; shift != 32; shift += 8) {
+        out += static_cast<char>((value >> shift) & 0xff);
+    }
+}
+
+inline auto valid_base(unsigned char value) noexcept -> bool {
+    return value <= static_cast<unsigned char>(base::hexadecimal);
+}
+
+// Whether every result of converting `input_size` characters fits in a
+// response frame.
+inline constexpr auto response_fits(base from, base to,
+                                    std::size_t input_size) noexcept -> bool {
+    return max_output_size(from, to, input_size) <=
+           max_frame_bytes - response_header_bytes;
+}
+
+enum class parse_status : unsigned char {
+    complete,
+    incomplete,
+    malformed,
+};
+
+// Parses the frame at the start of `buffer`. On success `consumed` is the
+// frame length and `out.item.input` points into `buffer`.
+inline auto parse_request(std::string_view buffer, request &out,
+                          std::size_t &consumed) noexcept -> parse_status {
+    if (buffer.size() < size_bytes) {
+        return parse_status::incomplete;
+    }
+
+    auto const size = load_u32(buffer.data());
+    if (size < request_header_bytes || size > max_frame_bytes) {
+        return parse_status::malformed;
+    }
+    if (buffer.size() - size_bytes < size) {
+        return parse_status::incomplete;
+    }
+
+    auto const *frame = buffer.data() + size_bytes;
+    auto const from = static_cast<unsigned char>(frame[4]);
+    auto const to = static_cast<unsigned char>(frame[5]);
+    if (!valid_base(from) || !valid_base(to)) {
+        return parse_status::malformed;
+    }
+
+    out.id = load_u32(frame);
+    out.item = {static_cast<base>(from), static_cast<base>(to),
+                std::string_view(frame + request_header_bytes,
+                                 size - request_header_bytes)};
+    consumed = size_bytes + size;
+    return parse_status::complete;
+}
+
+inline auto append_request(std::string &out, std::uint32_t id, base from,
+                           base to, std::string_view input) -> void {
+    append_u32(out, static_cast<std::uint32_t>(request_header_bytes +
+                                               input.size()));
+    append_u32(out, id);
+    out += static_cast<char>(from);
+    out += static_cast<char>(to);
+    out += input;
+}
+
+inline auto append_response(std::string &out, std::uint32_t id,
+                            batch_output const &output) -> void {
+    append_u32(out, static_cast<std::uint32_t>(response_header_bytes +
+                                               output.value.size()));
+    append_u32(out, id);
+    out += static_cast<char>(output.status);
+    out += output.value;
+}
+
+struct response {
+    std::uint32_t id{};
+    batch_status status{};
+    std::string_view value;
+};
+
+inline auto parse_response(std::string_view buffer, response &out,
+                           std::size_t &consumed) noexcept -> parse_status {
+    if (buffer.size() < size_bytes) {
+        return parse_status::incomplete;
+    }
+
+    auto const size = load_u32(buffer.data());
+    if (size < response_header_bytes || size > max_frame_bytes) {
+        return parse_status::malformed;
+    }
+    if (buffer.size() - size_bytes < size) {
+        return parse_status::incomplete;
+    }
+
+    auto const *frame = buffer.data() + size_bytes;
+    out.id = load_u32(frame);
+    out.status = static_cast<batch_status>(frame[4]);
+    out.value = std::string_view(frame + response_header_bytes,
+                                 size - response_header_bytes);
+    consumed = size_bytes + size;
+    return parse_status::complete;
+}
+} // namespace wire
+} // namespace base_conversion
+} // namespace evqovv
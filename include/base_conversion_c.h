@@ -0,0 +1,75 @@
+#ifndef EVQOVV_BASE_CONVERSION_C_H
+#define EVQOVV_BASE_CONVERSION_C_H
+
+#include <stddef.h>
+
+#if defined(_WIN32) && defined(BC_BUILDING_LIBRARY)
+#define BC_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define BC_API __declspec(dllimport)
+#elif defined(__GNUC__)
+#define BC_API __attribute__((visibility("default")))
+#else
+#define BC_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BC_VERSION_MAJOR 1
+#define BC_VERSION_MINOR 0
+
+typedef enum bc_base {
+    BC_BINARY = 0,
+    BC_OCTAL = 1,
+    BC_DECIMAL = 2,
+    BC_HEXADECIMAL = 3
+} bc_base;
+
+typedef enum bc_status {
+    BC_OK = 0,
+    BC_EMPTY_INPUT = 1,
+    BC_INVALID_CHARACTER = 2,
+    BC_OVERFLOW = 3,
+    BC_BUFFER_TOO_SMALL = 4,
+    BC_INVALID_BASE = 5,
+    BC_INVALID_ARGUMENT = 6
+} bc_status;
+
+typedef struct bc_batch_item {
+    const char *in;
+    size_t in_len;
+    char *out;
+    size_t out_cap;
+    size_t out_len;
+    bc_status status;
+} bc_batch_item;
+
+/* (major << 16) | minor of the loaded library. */
+BC_API unsigned bc_version(void);
+
+BC_API const char *bc_status_string(bc_status status);
+
+/* Upper bound on the output length for an input of in_len characters, or
+   0 for an invalid base. */
+BC_API size_t bc_max_output_size(bc_base from, bc_base to, size_t in_len);
+
+/* Converts in[0, in_len) and writes the digits, without a terminating NUL,
+   to out. On success and on BC_BUFFER_TOO_SMALL *out_len receives the
+   required length. Never allocates; safe to call from any thread. */
+BC_API bc_status bc_convert(bc_base from, bc_base to, const char *in,
+                            size_t in_len, char *out, size_t out_cap,
+                            size_t *out_len);
+
+/* Converts every item independently, storing per-item status and out_len.
+   Returns BC_OK when all items succeeded, otherwise the first failing
+   item's status. */
+BC_API bc_status bc_convert_batch(bc_base from, bc_base to,
+                                  bc_batch_item *items, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
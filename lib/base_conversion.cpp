@@ -0,0 +1,11 @@
+#define EVQOVV_BASE_CONVERSION_SOURCE
+#include "base_conversion.hpp"
+
+namespace evqovv {
+namespace base_conversion {
+template auto decimal_to_hexadecimal<true>(std::string_view str)
+    -> std::string;
+template auto decimal_to_hexadecimal<false>(std::string_view str)
+    -> std::string;
+} // namespace base_conversion
+} // namespace evqovv
@@ -0,0 +1,30 @@
+module;
+
+#include "base_conversion.hpp"
+#include "base_conversion/buffer.hpp"
+
+export module evqovv.base_conversion;
+
+export namespace evqovv::base_conversion {
+using base_conversion::base;
+
+using base_conversion::binary_to_decimal;
+using base_conversion::binary_to_hexadecimal;
+using base_conversion::binary_to_octal;
+using base_conversion::convert;
+using base_conversion::decimal_to_binary;
+using base_conversion::decimal_to_hexadecimal;
+using base_conversion::decimal_to_octal;
+using base_conversion::hexadecimal_to_binary;
+using base_conversion::hexadecimal_to_decimal;
+using base_conversion::hexadecimal_to_octal;
+using base_conversion::octal_to_binary;
+using base_conversion::octal_to_decimal;
+using base_conversion::octal_to_hexadecimal;
+using base_conversion::zero_padding;
+
+using base_conversion::conversion_errc;
+using base_conversion::conversion_result;
+using base_conversion::convert_into;
+using base_conversion::max_output_size;
+} // namespace evqovv::base_conversion
@@ -0,0 +1,65 @@
+#include "base_conversion.hpp"
+#include "base_conversion/alphabet.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+template <typename Alphabet>
+auto test_alphabet() -> void {
+    for (int round{}; round != 500; ++round) {
+        auto const value = inputs::value();
+        auto const encoded = encode<Alphabet>(value);
+        check::that(decode<Alphabet>(encoded) == value);
+
+        auto const wide =
+            (static_cast<details::uint128>(inputs::engine()) << 64 |
+             inputs::engine()) >>
+            (inputs::engine() % 128);
+        check::that(decode<Alphabet, details::uint128>(
+                        encode<Alphabet>(wide)) == wide);
+
+        // The string forms agree with the fixed-width ones.
+        auto const decimal = std::to_string(value);
+        check::equal(encode<Alphabet>(base::decimal, decimal), encoded);
+        check::equal(encode<Alphabet>(base::hexadecimal,
+                                      decimal_to_hexadecimal(decimal)),
+                     encoded);
+        check::equal(decode<Alphabet>(encoded, base::decimal), decimal);
+    }
+
+    check::equal(encode<Alphabet>(std::uint64_t{0}), "0");
+    check::equal(encode<Alphabet>(std::uint64_t{1}, 4), "0001");
+
+    // Longer than any uint64_t in this alphabet, but fine as a string.
+    std::string const large(64, Alphabet::characters.back());
+    check::throws<std::overflow_error>([&] { decode<Alphabet>(large); });
+    check::equal(encode<Alphabet>(base::decimal,
+                                  decode<Alphabet>(large, base::decimal)),
+                 large);
+
+    check::throws<std::invalid_argument>([] { decode<Alphabet>("1-2"); });
+    check::throws<std::invalid_argument>([] { decode<Alphabet>(""); });
+}
+} // namespace
+
+auto main() -> int {
+    test_alphabet<base36>();
+    test_alphabet<base62>();
+    test_alphabet<crockford_base32>();
+
+    check::equal(encode<base62>(std::uint64_t{61}), "z");
+    check::equal(encode<base62>(std::uint64_t{62}), "10");
+    check::that(decode<base36>("zz") == 36 * 36 - 1);
+    check::that(decode<crockford_base32>("o0il") == 32 + 1);
+    check::equal(encode<crockford_base32>(~details::uint128{}),
+                 "7ZZZZZZZZZZZZZZZZZZZZZZZZZ");
+
+    return check::result();
+}
@@ -0,0 +1,58 @@
+#include "base_conversion/base85.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+auto main() -> int {
+    // The examples from the Z85 specification and the Ascii85 article.
+    std::vector<std::uint8_t> const hello{0x86, 0x4F, 0xD2, 0x6F,
+                                          0xB5, 0x59, 0xF7, 0x5B};
+    check::equal(encode_z85(hello), "HelloWorld");
+    check::that(decode_z85("HelloWorld") == hello);
+
+    std::string_view const man = "Man is distinguished";
+    std::vector<std::uint8_t> const man_bytes(man.begin(), man.end());
+    check::equal(encode_ascii85(man_bytes), "9jqo^BlbD-BleB1DJ+*+F(f,q");
+    check::that(decode_ascii85("9jqo^BlbD-BleB1DJ+*+F(f,q") == man_bytes);
+
+    std::vector<std::uint8_t> const zeros(8);
+    check::equal(encode_ascii85(zeros), "zz");
+    check::that(decode_ascii85("zz") == zeros);
+
+    std::vector<std::uint8_t> const ones(4, 0xFF);
+    check::equal(encode_z85(ones), "%nSc0");
+    check::equal(encode_ascii85(ones), "s8W-!");
+
+    for (std::size_t size{}; size != 64; ++size) {
+        std::vector<std::uint8_t> data(size);
+        for (auto &byte : data) {
+            byte = inputs::engine() % 3 == 0
+                       ? 0
+                       : static_cast<std::uint8_t>(inputs::engine());
+        }
+        check::that(decode_ascii85(encode_ascii85(data)) == data);
+
+        data.resize(size / 4 * 4);
+        check::that(decode_z85(encode_z85(data)) == data);
+    }
+
+    check::throws<std::invalid_argument>(
+        [&] { encode_z85(std::span(man_bytes).first(3)); });
+    check::throws<std::invalid_argument>([] { decode_z85("1234"); });
+    check::throws<std::invalid_argument>([] { decode_z85("Hell~World"); });
+    // Above 2^32 - 1.
+    check::throws<std::invalid_argument>([] { decode_z85("#####"); });
+    check::throws<std::invalid_argument>([] { decode_ascii85("s8W-\""); });
+    check::throws<std::invalid_argument>([] { decode_ascii85("9jqo^B"); });
+
+    return check::result();
+}
@@ -0,0 +1,99 @@
+#include "base_conversion/buffer.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+constexpr base bases[]{base::binary, base::octal, base::decimal,
+                       base::hexadecimal};
+
+auto alphabet_of(base b) -> std::string_view {
+    switch (b) {
+    case base::binary:
+        return "01";
+    case base::octal:
+        return "01234567";
+    case base::decimal:
+        return "0123456789";
+    default:
+        return "0123456789abcdefABCDEF";
+    }
+}
+
+// convert()'s result, or the error it throws mapped to conversion_errc.
+auto expected_of(base from, base to, std::string_view str)
+    -> std::pair<conversion_errc, std::string> {
+    try {
+        return {conversion_errc::ok, convert(from, to, str)};
+    } catch (std::overflow_error const &) {
+        return {conversion_errc::overflow, {}};
+    } catch (std::invalid_argument const &) {
+        return {str.empty() ? conversion_errc::empty_string
+                            : conversion_errc::invalid_character,
+                {}};
+    }
+}
+} // namespace
+
+auto main() -> int {
+    // convert_into() agrees with convert() for every pair, same-base
+    // hexadecimal included, and stays within max_output_size().
+    for (auto from : bases) {
+        for (auto to : bases) {
+            for (std::size_t length = 1; length <= 90; ++length) {
+                // Runs of zeros exercise the zero-run skip.
+                auto str = std::string(inputs::engine() % 3, '0') +
+                           inputs::digits(alphabet_of(from), length);
+                if (length % 3 == 0) {
+                    str.insert(str.size() / 2, length, '0');
+                }
+                if (from == base::decimal || to == base::decimal) {
+                    str = str.substr(0, 19);
+                }
+
+                auto const [ec, value] = expected_of(from, to, str);
+                std::vector<char> out(max_output_size(from, to, str.size()));
+                auto const result = convert_into(from, to, str, out);
+                check::that(result.ec == ec);
+                if (ec == conversion_errc::ok) {
+                    check::equal(std::string_view(out.data(), result.size),
+                                 value);
+
+                    // One character short reports the size it needs.
+                    auto const short_result =
+                        convert_into(from, to, str,
+                                     std::span(out.data(), value.size() - 1));
+                    check::that(short_result.ec ==
+                                conversion_errc::buffer_too_small);
+                    check::that(short_result.size == value.size());
+                }
+            }
+        }
+    }
+
+    char out[64];
+    check::that(convert_into(base::hexadecimal, base::hexadecimal, "00aBc", out)
+                    .size == 3);
+    check::equal(std::string_view(out, 3), "ABC");
+    check::that(convert_into(base::binary, base::hexadecimal, "", out).ec ==
+                conversion_errc::empty_string);
+    check::that(convert_into(base::octal, base::binary, "0008", out).ec ==
+                conversion_errc::invalid_character);
+    check::that(convert_into(base::hexadecimal, base::decimal,
+                             "10000000000000000", out)
+                    .ec == conversion_errc::overflow);
+    // The whole input is validated before the overflow is noticed.
+    check::that(convert_into(base::hexadecimal, base::decimal,
+                             "10000000000000000g", out)
+                    .ec == conversion_errc::invalid_character);
+
+    return check::result();
+}
@@ -0,0 +1,162 @@
+#include "base_conversion/cache.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+constexpr base bases[]{base::binary, base::octal, base::decimal,
+                       base::hexadecimal};
+
+auto alphabet_of(base b) -> std::string_view {
+    switch (b) {
+    case base::binary:
+        return "01";
+    case base::octal:
+        return "01234567";
+    case base::decimal:
+        return "0123456789";
+    default:
+        return "0123456789abcdefABCDEF";
+    }
+}
+} // namespace
+
+auto main() -> int {
+    check::throws<std::invalid_argument>(
+        [] { conversion_cache(cache_options{.shard_count = 0}); });
+    check::throws<std::invalid_argument>(
+        [] { conversion_cache(cache_options{.slot_bytes = 0}); });
+
+    // Misses and hits both return what convert() does, same-base pairs
+    // included.
+    {
+        conversion_cache cache;
+        std::size_t lookups{};
+        for (auto from : bases) {
+            for (auto to : bases) {
+                // Short enough for every pair to fit uint64_t.
+                for (std::size_t length = 1; length <= 16; ++length) {
+                    auto const str = inputs::digits(alphabet_of(from), length);
+                    auto const expected = convert(from, to, str);
+                    check::equal(cache.convert(from, to, str), expected);
+                    check::equal(cache.convert(from, to, str), expected);
+                    lookups += 2;
+                }
+            }
+        }
+        auto const stats = cache.stats();
+        check::that(stats.hits + stats.misses == lookups);
+        check::that(stats.hits >= lookups / 2 - stats.uncacheable);
+        check::that(stats.evictions == 0);
+    }
+
+    // The same digits under another pair are a different entry.
+    {
+        conversion_cache cache;
+        check::equal(cache.convert(base::binary, base::decimal, "101"), "5");
+        check::equal(cache.convert(base::decimal, base::binary, "101"),
+                     "1100101");
+        check::equal(cache.convert(base::octal, base::decimal, "101"), "65");
+        check::that(cache.stats().hits == 0);
+    }
+
+    // Results that do not fit a slot are passed through, and errors are
+    // rethrown without being cached.
+    {
+        conversion_cache cache(cache_options{.slot_bytes = 8});
+        std::string const wide(16, '1');
+        check::equal(cache.convert(base::binary, base::hexadecimal, wide),
+                     "FFFF");
+        check::equal(cache.convert(base::binary, base::hexadecimal, wide),
+                     "FFFF");
+        check::that(cache.stats().uncacheable == 2);
+        check::that(cache.stats().hits == 0);
+
+        for (int round{}; round != 2; ++round) {
+            check::throws<std::invalid_argument>(
+                [&] { cache.convert(base::binary, base::decimal, "102"); });
+        }
+        check::that(cache.stats().hits == 0);
+    }
+
+    // A single slot evicts on every new key.
+    {
+        conversion_cache cache(
+            cache_options{.shard_count = 1, .slots_per_shard = 1});
+        cache.convert(base::decimal, base::binary, "1");
+        cache.convert(base::decimal, base::binary, "2");
+        cache.convert(base::decimal, base::binary, "3");
+        check::that(cache.stats().evictions == 2);
+        check::equal(cache.convert(base::decimal, base::binary, "3"), "11");
+        check::that(cache.stats().hits == 1);
+    }
+
+    // A pair that misses through a whole window bypasses the cache for the
+    // cooldown, then is looked up again.
+    {
+        conversion_cache cache(cache_options{
+            .min_hit_rate = 0.5, .window = 4, .cooldown = 3});
+        for (int i{}; i != 4; ++i) {
+            cache.convert(base::decimal, base::hexadecimal,
+                          std::to_string(i));
+        }
+        check::that(cache.stats().disabled_pairs == 1);
+
+        // Other pairs are unaffected.
+        cache.convert(base::decimal, base::octal, "8");
+        check::that(cache.stats().bypassed == 0);
+
+        for (int i{}; i != 3; ++i) {
+            check::equal(cache.convert(base::decimal, base::hexadecimal, "255"),
+                         "FF");
+        }
+        auto const stats = cache.stats();
+        check::that(stats.bypassed == 3);
+        check::that(stats.disabled_pairs == 0);
+
+        cache.convert(base::decimal, base::hexadecimal, "0");
+        check::that(cache.stats().hits == 1);
+    }
+
+    // Threads sharing a small cache keep getting correct results while
+    // they evict each other.
+    {
+        conversion_cache cache(
+            cache_options{.shard_count = 2, .slots_per_shard = 8});
+        std::vector<std::string> keys;
+        for (int i{}; i != 64; ++i) {
+            keys.push_back(inputs::digits("0123456789", 12));
+        }
+
+        std::vector<int> wrong(4);
+        std::vector<std::thread> threads;
+        for (std::size_t t{}; t != wrong.size(); ++t) {
+            threads.emplace_back([&, t] {
+                for (int round{}; round != 2000; ++round) {
+                    auto const &key = keys[(round * 7 + t) % keys.size()];
+                    if (cache.convert(base::decimal, base::hexadecimal, key) !=
+                        decimal_to_hexadecimal(key)) {
+                        ++wrong[t];
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        for (auto count : wrong) {
+            check::that(count == 0);
+        }
+    }
+
+    return check::result();
+}
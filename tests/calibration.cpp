@@ -0,0 +1,81 @@
+#include "base_conversion/calibration.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+auto const profile =
+    (std::filesystem::temp_directory_path() /
+     "base_conversion_test_calibration.profile")
+        .string();
+
+auto write_profile(std::string_view contents) -> void {
+    std::ofstream(profile, std::ios::binary) << contents;
+}
+} // namespace
+
+auto main() -> int {
+    // save_profile() writes every crossover and load_profile() reads them
+    // back unchanged.
+    tuning::thresholds const saved{.direct_transcode_min_length = 96,
+                                   .parallel_min_length = 3 << 20};
+    tuning::save_profile(profile, saved);
+    auto const loaded = tuning::load_profile(profile);
+    check::that(loaded.direct_transcode_min_length == 96);
+    check::that(loaded.parallel_min_length == 3 << 20);
+
+    // CRLF line ends, unknown names and lines without '=' are accepted;
+    // entries that are missing keep their defaults.
+    write_profile("direct_transcode_min_length=7\r\n"
+                  "unknown=12\r\n"
+                  "a comment\r\n");
+    auto const partial = tuning::load_profile(profile);
+    check::that(partial.direct_transcode_min_length == 7);
+    check::that(partial.parallel_min_length ==
+                tuning::thresholds{}.parallel_min_length);
+
+    // A value must be a whole unsigned number.
+    for (std::string_view value : {"", "12x", "-1", " 12", "1 2",
+                                   "99999999999999999999999"}) {
+        write_profile("parallel_min_length=" + std::string(value) + "\n");
+        auto const message =
+            check::throws<std::runtime_error>([] {
+                tuning::load_profile(profile);
+            });
+        check::that(message.find("parallel_min_length") != std::string::npos);
+    }
+
+    std::filesystem::remove(profile);
+    check::throws<std::runtime_error>([] { tuning::load_profile(profile); });
+    check::throws<std::runtime_error>([] {
+        tuning::save_profile(profile + ".missing/profile", {});
+    });
+
+    // apply() is what current() reports afterwards.
+    auto const defaults = tuning::current();
+    tuning::apply(saved);
+    check::that(tuning::current().direct_transcode_min_length == 96);
+    check::that(tuning::current().parallel_min_length == 3 << 20);
+    tuning::apply(defaults);
+
+    // A budget too small to finish any sweep keeps the defaults, and
+    // calibrate() never applies what it measures.
+    auto const measured = tuning::calibrate(std::chrono::nanoseconds(1));
+    check::that(measured.direct_transcode_min_length ==
+                tuning::thresholds{}.direct_transcode_min_length);
+    check::that(measured.parallel_min_length ==
+                tuning::thresholds{}.parallel_min_length);
+    check::that(tuning::current().direct_transcode_min_length ==
+                defaults.direct_transcode_min_length);
+
+    return check::result();
+}
@@ -0,0 +1,114 @@
+#include "base_conversion/cancellation.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+constexpr base power_of_two_bases[]{base::binary, base::octal,
+                                    base::hexadecimal};
+
+auto alphabet_of(base b) -> std::string_view {
+    switch (b) {
+    case base::binary:
+        return "01";
+    case base::octal:
+        return "01234567";
+    default:
+        return "0123456789abcdefABCDEF";
+    }
+}
+} // namespace
+
+auto main() -> int {
+    using details::cancellation_chunk_size;
+
+    // Results match convert() on both sides of the chunk boundaries, with
+    // leading zeros and zero runs, and progress climbs to the total.
+    for (auto from : power_of_two_bases) {
+        for (auto to : power_of_two_bases) {
+            for (auto length :
+                 {std::size_t{1}, cancellation_chunk_size - 1,
+                  cancellation_chunk_size, cancellation_chunk_size + 1,
+                  3 * cancellation_chunk_size + 17}) {
+                auto str = std::string(length % 5, '0') +
+                           inputs::digits(alphabet_of(from), length);
+                str.insert(str.size() / 3, 100, '0');
+
+                std::vector<std::pair<std::size_t, std::size_t>> reports;
+                auto const result = convert(
+                    from, to, str, std::stop_token{},
+                    [&](std::size_t done, std::size_t total) {
+                        reports.emplace_back(done, total);
+                    });
+                check::equal(result, convert(from, to, str));
+
+                check::that(!reports.empty());
+                check::that(reports.back() ==
+                            std::pair(str.size(), str.size()));
+                for (std::size_t i = 1; i < reports.size(); ++i) {
+                    check::that(reports[i].first >= reports[i - 1].first);
+                }
+            }
+        }
+    }
+
+    check::equal(convert(base::decimal, base::hexadecimal, "255",
+                         std::stop_token{}),
+                 "FF");
+    check::equal(convert(base::hexadecimal, base::hexadecimal, "00ff",
+                         std::stop_token{}),
+                 "FF");
+
+    // Errors are the ones convert() throws, wherever the bad digit is.
+    auto const bad = std::string(2 * cancellation_chunk_size, '1') + "2" +
+                     std::string(10, '1');
+    check::equal(check::throws<std::invalid_argument>([&] {
+                     convert(base::binary, base::octal, bad, std::stop_token{});
+                 }),
+                 check::throws<std::invalid_argument>(
+                     [&] { convert(base::binary, base::octal, bad); }));
+    check::throws<std::invalid_argument>([] {
+        convert(base::binary, base::octal, "", std::stop_token{});
+    });
+    check::throws<std::invalid_argument>([&] {
+        convert(base::binary, base::binary, bad, std::stop_token{});
+    });
+
+    // A stop requested up front is seen before any work, on every path.
+    std::stop_source stopped;
+    stopped.request_stop();
+    for (auto [from, to] : {std::pair(base::binary, base::hexadecimal),
+                            std::pair(base::octal, base::octal),
+                            std::pair(base::decimal, base::binary)}) {
+        check::throws<conversion_cancelled>(
+            [&] { convert(from, to, "1", stopped.get_token()); });
+    }
+
+    // A stop requested while converting is seen at the next chunk.
+    std::stop_source source;
+    auto const large = inputs::digits("01", 8 * cancellation_chunk_size);
+    std::size_t last_report{};
+    check::throws<conversion_cancelled>([&] {
+        convert(base::binary, base::hexadecimal, large, source.get_token(),
+                [&](std::size_t done, std::size_t) {
+                    last_report = done;
+                    if (done >= 2 * cancellation_chunk_size) {
+                        source.request_stop();
+                    }
+                });
+    });
+    check::that(last_report >= 2 * cancellation_chunk_size);
+    check::that(last_report < 4 * cancellation_chunk_size);
+
+    return check::result();
+}
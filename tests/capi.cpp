@@ -0,0 +1,96 @@
+#include "base_conversion_c.h"
+
+#include "base_conversion.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+// Exercises the shared library through its exported C functions only.
+auto main() -> int {
+    check::that(bc_version() == (BC_VERSION_MAJOR << 16 | BC_VERSION_MINOR));
+    for (auto status : {BC_OK, BC_EMPTY_INPUT, BC_INVALID_CHARACTER,
+                        BC_OVERFLOW, BC_BUFFER_TOO_SMALL, BC_INVALID_BASE,
+                        BC_INVALID_ARGUMENT}) {
+        check::that(std::strlen(bc_status_string(status)) != 0);
+    }
+
+    // Results match convert(), uppercase hexadecimal included.
+    char out[128];
+    std::size_t out_len{};
+    for (auto from : {BC_BINARY, BC_OCTAL, BC_HEXADECIMAL}) {
+        for (auto to : {BC_BINARY, BC_OCTAL, BC_DECIMAL, BC_HEXADECIMAL}) {
+            std::string_view const alphabet =
+                from == BC_BINARY  ? "01"
+                : from == BC_OCTAL ? "01234567"
+                                   : "0123456789abcdef";
+            auto const input = inputs::digits(alphabet, to == BC_DECIMAL ? 8
+                                                                         : 24);
+            auto const expected = evqovv::base_conversion::convert(
+                static_cast<evqovv::base_conversion::base>(from),
+                static_cast<evqovv::base_conversion::base>(to), input);
+            check::that(bc_max_output_size(from, to, input.size()) >=
+                        expected.size());
+            check::that(bc_convert(from, to, input.data(), input.size(), out,
+                                   sizeof(out), &out_len) == BC_OK);
+            check::equal(std::string_view(out, out_len), expected);
+        }
+    }
+
+    check::that(bc_convert(BC_HEXADECIMAL, BC_HEXADECIMAL, "0ff", 3, out,
+                           sizeof(out), &out_len) == BC_OK);
+    check::equal(std::string_view(out, out_len), "FF");
+
+    // Too small a buffer reports the size needed, and a null buffer with no
+    // capacity is how callers ask for it.
+    check::that(bc_convert(BC_BINARY, BC_DECIMAL, "11111111", 8, out, 2,
+                           &out_len) == BC_BUFFER_TOO_SMALL);
+    check::that(out_len == 3);
+    check::that(bc_convert(BC_BINARY, BC_HEXADECIMAL, "11111111", 8, nullptr, 0,
+                           &out_len) == BC_BUFFER_TOO_SMALL);
+    check::that(out_len == 2);
+
+    check::that(bc_convert(BC_BINARY, BC_OCTAL, "", 0, out, sizeof(out),
+                           &out_len) == BC_EMPTY_INPUT);
+    check::that(bc_convert(BC_BINARY, BC_OCTAL, "102", 3, out, sizeof(out),
+                           &out_len) == BC_INVALID_CHARACTER);
+    check::that(bc_convert(BC_HEXADECIMAL, BC_DECIMAL, "10000000000000000", 17,
+                           out, sizeof(out), &out_len) == BC_OVERFLOW);
+    check::that(bc_convert(static_cast<bc_base>(4), BC_OCTAL, "1", 1, out,
+                           sizeof(out), &out_len) == BC_INVALID_BASE);
+    check::that(bc_convert(BC_BINARY, BC_OCTAL, nullptr, 1, out, sizeof(out),
+                           &out_len) == BC_INVALID_ARGUMENT);
+    check::that(bc_convert(BC_BINARY, BC_OCTAL, "1", 1, nullptr, 4,
+                           &out_len) == BC_INVALID_ARGUMENT);
+    check::that(bc_max_output_size(BC_BINARY, static_cast<bc_base>(-1), 1) ==
+                0);
+
+    // Every batch item gets its own status; the first failure is returned.
+    char first[8];
+    char second[8];
+    char third[1];
+    bc_batch_item items[]{
+        {"1010", 4, first, sizeof(first), 0, BC_OK},
+        {"12", 2, second, sizeof(second), 0, BC_OK},
+        {"1111", 4, third, sizeof(third), 0, BC_OK},
+    };
+    check::that(bc_convert_batch(BC_BINARY, BC_DECIMAL, items, 3) ==
+                BC_INVALID_CHARACTER);
+    check::that(items[0].status == BC_OK);
+    check::equal(std::string_view(first, items[0].out_len), "10");
+    check::that(items[1].status == BC_INVALID_CHARACTER);
+    check::that(items[2].status == BC_BUFFER_TOO_SMALL);
+    check::that(items[2].out_len == 2);
+    check::that(bc_convert_batch(BC_BINARY, BC_DECIMAL, items, 1) == BC_OK);
+    check::that(bc_convert_batch(BC_BINARY, BC_DECIMAL, nullptr, 0) == BC_OK);
+    check::that(bc_convert_batch(BC_BINARY, BC_DECIMAL, nullptr, 1) ==
+                BC_INVALID_ARGUMENT);
+    check::that(bc_convert_batch(BC_DECIMAL, static_cast<bc_base>(9), items,
+                                 1) == BC_INVALID_BASE);
+
+    return check::result();
+}
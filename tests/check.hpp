@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdio>
+#include <exception>
+#include <source_location>
+#include <string>
+#include <string_view>
+
+// Minimal assertions for the test executables: failures are printed and
+// counted, and main() returns check::result().
+namespace check {
+inline int failures = 0;
+
+inline auto fail(std::string_view message, std::source_location where)
+    -> void {
+    ++failures;
+    std::fprintf(stderr, "%s:%u: %.*s\n", where.file_name(), where.line(),
+                 static_cast<int>(message.size()), message.data());
+}
+
+inline auto that(bool condition,
+                 std::source_location where = std::source_location::current())
+    -> void {
+    if (!condition) {
+        fail("check failed", where);
+    }
+}
+
+template <typename T, typename U>
+auto equal(T const &actual, U const &expected,
+           std::source_location where = std::source_location::current())
+    -> void {
+    if (!(actual == expected)) {
+        if constexpr (requires { std::string_view(actual); }) {
+            fail("got \"" + std::string(std::string_view(actual)) +
+                     "\", expected \"" +
+                     std::string(std::string_view(expected)) + "\"",
+                 where);
+        } else {
+            fail("values differ", where);
+        }
+    }
+}
+
+// `f()` must throw `Exception`; its what() is returned, or "" otherwise.
+template <typename Exception, typename F>
+auto throws(F &&f,
+            std::source_location where = std::source_location::current())
+    -> std::string {
+    try {
+        f();
+    } catch (Exception const &e) {
+        return e.what();
+    } catch (std::exception const &e) {
+        fail(std::string("threw another exception: ") + e.what(), where);
+        return {};
+    }
+    fail("did not throw", where);
+    return {};
+}
+
+inline auto result() -> int {
+    if (failures != 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
+} // namespace check
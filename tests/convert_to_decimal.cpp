@@ -0,0 +1,80 @@
+#include "base_conversion.hpp"
+#include "base_conversion/big_number.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+auto to_decimal(base from, std::string_view str, std::size_t *chunks = nullptr)
+    -> std::string {
+    std::string result;
+    std::size_t count{};
+    convert_to_decimal(from, str, [&](std::string_view chunk) {
+        result += chunk;
+        ++count;
+    });
+    if (chunks != nullptr) {
+        *chunks = count;
+    }
+    return result;
+}
+} // namespace
+
+auto main() -> int {
+    for (int round{}; round != 500; ++round) {
+        auto const binary = decimal_to_binary(std::to_string(inputs::value()));
+        auto const padded = std::string(inputs::engine() % 3, '0') + binary;
+        check::equal(to_decimal(base::binary, padded),
+                     binary_to_decimal(padded));
+        check::equal(to_decimal(base::octal, binary_to_octal(binary)),
+                     binary_to_decimal(binary));
+        check::equal(to_decimal(base::hexadecimal,
+                                binary_to_hexadecimal(binary)),
+                     binary_to_decimal(binary));
+    }
+
+    // Round trips through decimal_parser, across the sizes where the
+    // division tree gains levels and where groups of zeros must be padded.
+    for (std::size_t length = 1; length <= 3000; length += 37) {
+        auto decimal = inputs::digits("0123456789", length);
+        if (length % 3 == 0) {
+            for (std::size_t i = 1; i < decimal.size(); i += 2) {
+                decimal[i] = '0';
+            }
+        }
+
+        decimal_parser parser;
+        parser.feed(decimal);
+        auto const hexadecimal = parser.finish(base::hexadecimal);
+        check::equal(to_decimal(base::hexadecimal, hexadecimal),
+                     inputs::trimmed(decimal));
+    }
+
+    // One followed by zeros splits into chunks of zeros only.
+    std::string const power_of_ten = "1" + std::string(2000, '0');
+    decimal_parser parser;
+    parser.feed(power_of_ten);
+    std::size_t chunks{};
+    check::equal(to_decimal(base::binary, parser.finish(base::binary), &chunks),
+                 power_of_ten);
+    check::that(chunks > 1);
+
+    check::equal(to_decimal(base::hexadecimal, "0000"), "0");
+    check::equal(to_decimal(base::decimal, "00120"), "120");
+
+    check::throws<std::invalid_argument>(
+        [] { to_decimal(base::hexadecimal, "12G4"); });
+    check::throws<std::invalid_argument>(
+        [] { to_decimal(base::decimal, "12a"); });
+    check::throws<std::invalid_argument>(
+        [] { to_decimal(base::octal, ""); });
+
+    return check::result();
+}
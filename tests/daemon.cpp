@@ -0,0 +1,168 @@
+#include "base_conversion/wire.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "check.hpp"
+
+using namespace evqovv::base_conversion;
+
+// Runs the daemon given as the first argument and talks to it over a socket
+// in the temporary directory.
+namespace {
+auto connect_to(std::string const &path) -> int {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    // The daemon binds its socket some time after starting.
+    for (int attempt{}; attempt != 500; ++attempt) {
+        auto const fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (::connect(fd, reinterpret_cast<sockaddr *>(&address),
+                      sizeof(address)) == 0) {
+            return fd;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    throw std::runtime_error("cannot connect to the daemon");
+}
+
+auto send_all(int fd, std::string_view data) -> void {
+    while (!data.empty()) {
+        auto const n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (n <= 0) {
+            throw std::runtime_error("send failed");
+        }
+        data.remove_prefix(static_cast<std::size_t>(n));
+    }
+}
+
+struct result {
+    std::uint32_t id{};
+    batch_status status{};
+    std::string value;
+};
+
+// Sends one request and waits for its response, so a large response never
+// backs up behind requests still being written.
+auto round_trip(int fd, std::uint32_t id, base from, base to,
+                std::string_view input) -> result {
+    std::string out;
+    wire::append_request(out, id, from, to, input);
+    send_all(fd, out);
+
+    std::string in;
+    while (true) {
+        wire::response response;
+        std::size_t consumed{};
+        auto const status = wire::parse_response(in, response, consumed);
+        if (status == wire::parse_status::malformed) {
+            throw std::runtime_error("malformed response");
+        }
+        if (status == wire::parse_status::complete) {
+            if (consumed != in.size()) {
+                throw std::runtime_error("unexpected extra response");
+            }
+            return {response.id, response.status, std::string(response.value)};
+        }
+
+        char buffer[64 * 1024];
+        auto const n = ::read(fd, buffer, sizeof(buffer));
+        if (n <= 0) {
+            throw std::runtime_error("connection closed");
+        }
+        in.append(buffer, static_cast<std::size_t>(n));
+    }
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <daemon>\n", argv[0]);
+        return 2;
+    }
+
+    auto const socket_path =
+        (std::filesystem::temp_directory_path() /
+         ("base_conversion_test_daemon." + std::to_string(::getpid())))
+            .string();
+    char *const daemon_argv[]{argv[1], const_cast<char *>(socket_path.c_str()),
+                              nullptr};
+    pid_t daemon{};
+    if (::posix_spawn(&daemon, argv[1], nullptr, nullptr, daemon_argv,
+                      environ) != 0) {
+        std::perror("posix_spawn");
+        return 1;
+    }
+
+    try {
+        auto const fd = connect_to(socket_path);
+
+        auto const small =
+            round_trip(fd, 1, base::hexadecimal, base::decimal, "ff");
+        check::that(small.id == 1);
+        check::that(small.status == batch_status::ok);
+        check::equal(small.value, "255");
+
+        auto const invalid =
+            round_trip(fd, 2, base::binary, base::decimal, "102");
+        check::that(invalid.status == batch_status::invalid_argument);
+
+        // The largest hexadecimal input whose binary result still fits in a
+        // response frame is converted and arrives whole.
+        constexpr auto payload =
+            wire::max_frame_bytes - wire::response_header_bytes;
+        std::string const largest(payload / 4, 'F');
+        auto const fits =
+            round_trip(fd, 3, base::hexadecimal, base::binary, largest);
+        check::that(fits.id == 3);
+        check::that(fits.status == batch_status::ok);
+        check::that(fits.value.size() == largest.size() * 4);
+        check::that(fits.value.find_first_not_of('1') == std::string::npos);
+
+        // One more digit, or a 20 MB request, is refused instead of being
+        // answered with a frame the client would reject.
+        for (auto const size : {payload / 4 + 1, std::size_t{20} << 20}) {
+            auto const refused =
+                round_trip(fd, 4, base::hexadecimal, base::binary,
+                           std::string(size, 'F'));
+            check::that(refused.id == 4);
+            check::that(refused.status == batch_status::invalid_argument);
+        }
+
+        // The connection stays usable after a refusal.
+        auto const after =
+            round_trip(fd, 5, base::decimal, base::hexadecimal, "255");
+        check::that(after.id == 5);
+        check::equal(after.value, "FF");
+
+        ::close(fd);
+    } catch (std::exception const &e) {
+        check::fail(e.what(), std::source_location::current());
+    }
+
+    ::kill(daemon, SIGTERM);
+    int status{};
+    ::waitpid(daemon, &status, 0);
+    check::that(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    check::that(!std::filesystem::exists(socket_path));
+
+    return check::result();
+}
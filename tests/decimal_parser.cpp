@@ -0,0 +1,69 @@
+#include "base_conversion.hpp"
+#include "base_conversion/big_number.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+auto main() -> int {
+    // Values that still fit in uint64_t against convert().
+    for (int round{}; round != 500; ++round) {
+        auto const decimal = std::string(inputs::engine() % 3, '0') +
+                             std::to_string(inputs::value());
+
+        decimal_parser parser;
+        parser.feed(decimal);
+        check::equal(parser.finish(base::hexadecimal),
+                     convert(base::decimal, base::hexadecimal, decimal));
+        parser.feed(decimal);
+        check::equal(parser.finish(base::octal),
+                     convert(base::decimal, base::octal, decimal));
+    }
+
+    // Longer values: any split into chunks gives the same result, and the
+    // outputs agree with each other.
+    for (std::size_t length = 1; length <= 400; length += 7) {
+        auto const decimal = inputs::digits("0123456789", length);
+
+        decimal_parser parser;
+        parser.feed(decimal);
+        auto const whole = parser.finish(base::hexadecimal);
+
+        for (std::size_t pos{}; pos != decimal.size();) {
+            auto const size = std::min<std::size_t>(
+                1 + inputs::engine() % 40, decimal.size() - pos);
+            parser.feed(std::string_view(decimal).substr(pos, size));
+            pos += size;
+        }
+        check::equal(parser.finish(base::hexadecimal), whole);
+
+        parser.feed(decimal);
+        check::equal(parser.finish(base::binary),
+                     hexadecimal_to_binary(whole));
+        parser.feed(decimal);
+        check::equal(parser.finish(base::decimal), inputs::trimmed(decimal));
+    }
+
+    decimal_parser parser;
+    parser.feed("");
+    parser.feed("0000");
+    check::equal(parser.finish(base::binary), "0");
+
+    // A rejected chunk leaves the parser empty.
+    check::throws<std::invalid_argument>([&] { parser.feed("12x"); });
+    parser.feed("3");
+    check::equal(parser.finish(base::decimal), "3");
+    check::throws<std::invalid_argument>([&] { parser.feed("9-"); });
+    check::equal(check::throws<std::invalid_argument>(
+                     [&] { parser.finish(base::decimal); }),
+                 "base conversion error: string is empty");
+
+    return check::result();
+}
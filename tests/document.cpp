@@ -0,0 +1,92 @@
+#include "base_conversion/document.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+// Applies random edits to a document and to a plain string, and checks
+// after each that binary() is what converting the string gives.
+template <base from>
+auto edit_randomly(std::string_view alphabet, auto reference_to_binary)
+    -> void {
+    std::string reference = inputs::digits(alphabet, 40);
+    binary_document<from> document(reference);
+    check::equal(document.binary(), reference_to_binary(reference));
+
+    for (int round{}; round != 2000; ++round) {
+        auto const pos = inputs::engine() % (reference.size() + 1);
+        // Mostly zeros, so the first set bit keeps moving.
+        auto const digits =
+            inputs::engine() % 2 == 0
+                ? std::string(1 + inputs::engine() % 4, '0')
+                : inputs::digits(alphabet, 1 + inputs::engine() % 4);
+
+        switch (inputs::engine() % 3) {
+        case 0:
+            document.insert(pos, digits);
+            reference.insert(pos, digits);
+            break;
+        case 1:
+            if (digits.size() <= reference.size() - pos) {
+                document.replace(pos, digits);
+                reference.replace(pos, digits.size(), digits);
+            }
+            break;
+        default: {
+            auto const count = std::min(digits.size(), reference.size() - pos);
+            if (count < reference.size()) {
+                document.erase(pos, count);
+                reference.erase(pos, count);
+            }
+        }
+        }
+
+        check::equal(document.input(), reference);
+        check::that(document.size() == reference.size());
+        // Only every few edits, so some edits land on a stale position.
+        if (round % 3 == 0) {
+            check::equal(document.binary(), reference_to_binary(reference));
+        }
+    }
+}
+} // namespace
+
+auto main() -> int {
+    edit_randomly<base::hexadecimal>(
+        "0123456789abcdefABCDEF",
+        [](std::string_view str) { return hexadecimal_to_binary(str); });
+    edit_randomly<base::octal>(
+        "01234567", [](std::string_view str) { return octal_to_binary(str); });
+
+    check::throws<std::invalid_argument>(
+        [] { hexadecimal_binary_document(""); });
+    check::throws<std::invalid_argument>([] { octal_binary_document("18"); });
+
+    // Rejected edits leave the document as it was.
+    hexadecimal_binary_document document("00f0");
+    check::equal(document.binary(), "11110000");
+    check::throws<std::out_of_range>([&] { document.insert(5, "1"); });
+    check::throws<std::out_of_range>([&] { document.replace(3, "12"); });
+    check::throws<std::out_of_range>([&] { document.erase(2, 3); });
+    check::throws<std::invalid_argument>([&] { document.insert(0, "g"); });
+    check::throws<std::invalid_argument>([&] { document.replace(0, "-"); });
+    check::throws<std::invalid_argument>([&] { document.erase(0, 4); });
+    check::equal(document.input(), "00f0");
+    check::equal(document.binary(), "11110000");
+
+    document.replace(0, "000");
+    check::equal(document.binary(), "0");
+    document.erase(0, 3);
+    check::equal(document.binary(), "0");
+    document.insert(1, "1");
+    check::equal(document.binary(), "1");
+
+    return check::result();
+}
@@ -0,0 +1,152 @@
+#include "base_conversion/batch.hpp"
+#include "base_conversion/executor.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+static_assert(executor<inline_executor>);
+static_assert(executor<thread_pool>);
+
+// Runs `count` tasks and checks each ran exactly once.
+template <executor Executor>
+auto runs_each_once(Executor &executor, std::size_t count) -> void {
+    std::vector<std::atomic<int>> runs(count);
+    executor.bulk_execute(count, [&](std::size_t i) { ++runs[i]; });
+    for (auto const &run : runs) {
+        check::that(run.load() == 1);
+    }
+}
+
+// Throws from some tasks; the first exception surfaces only after every
+// task has run.
+template <executor Executor>
+auto rethrows_after_all(Executor &executor) -> void {
+    std::atomic<std::size_t> finished{};
+    check::throws<std::runtime_error>([&] {
+        executor.bulk_execute(64, [&](std::size_t i) {
+            ++finished;
+            if (i % 10 == 3) {
+                throw std::runtime_error("task failed");
+            }
+        });
+    });
+    check::that(finished.load() == 64);
+}
+
+// A host pool: each submitted job runs on a thread of its own, joined when
+// the pool goes away.
+struct host_pool {
+    std::mutex mutex;
+    std::vector<std::thread> threads;
+    std::size_t submitted{};
+
+    auto submit(std::function<void()> job) -> void {
+        std::lock_guard lock(mutex);
+        ++submitted;
+        threads.emplace_back(std::move(job));
+    }
+
+    ~host_pool() {
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+};
+} // namespace
+
+auto main() -> int {
+    // inline_executor runs in order on the calling thread.
+    inline_executor serial;
+    check::that(serial.concurrency() == 1);
+    std::vector<std::size_t> order;
+    auto const caller = std::this_thread::get_id();
+    serial.bulk_execute(5, [&](std::size_t i) {
+        check::that(std::this_thread::get_id() == caller);
+        order.push_back(i);
+    });
+    check::that(order == std::vector<std::size_t>{0, 1, 2, 3, 4});
+    runs_each_once(serial, 0);
+    check::throws<std::runtime_error>([&] {
+        serial.bulk_execute(
+            3, [](std::size_t) { throw std::runtime_error("task failed"); });
+    });
+
+    // thread_pool counts the caller, and several callers may share it.
+    {
+        thread_pool pool(3);
+        check::that(pool.concurrency() == 4);
+        runs_each_once(pool, 0);
+        runs_each_once(pool, 1);
+        runs_each_once(pool, 1000);
+        rethrows_after_all(pool);
+
+        std::vector<std::thread> callers;
+        for (int c{}; c != 4; ++c) {
+            callers.emplace_back([&] {
+                for (int round{}; round != 50; ++round) {
+                    runs_each_once(pool, 37);
+                }
+            });
+        }
+        for (auto &caller : callers) {
+            caller.join();
+        }
+
+        thread_pool alone(0);
+        check::that(alone.concurrency() == 1);
+        runs_each_once(alone, 10);
+    }
+
+    // pool_executor hands out at most concurrency - 1 helper jobs per call.
+    {
+        host_pool host;
+        pool_executor forwarding(
+            [&](std::function<void()> job) { host.submit(std::move(job)); },
+            3);
+        static_assert(executor<decltype(forwarding)>);
+        check::that(forwarding.concurrency() == 3);
+        runs_each_once(forwarding, 100);
+        check::that(host.submitted == 2);
+        runs_each_once(forwarding, 2);
+        check::that(host.submitted == 3);
+        rethrows_after_all(forwarding);
+
+        pool_executor at_least_one([](std::function<void()>) {}, 0);
+        check::that(at_least_one.concurrency() == 1);
+        runs_each_once(at_least_one, 10);
+    }
+
+    // convert_batch() gives the same results on an executor as without one.
+    std::vector<std::string> storage;
+    for (int i{}; i != 500; ++i) {
+        storage.push_back(i % 50 == 7 ? std::string("12x")
+                                      : inputs::digits("0123456789", 12));
+    }
+    std::vector<batch_item> items;
+    for (auto const &input : storage) {
+        items.push_back({base::decimal, base::hexadecimal, input});
+    }
+    thread_pool pool(2);
+    auto const expected = convert_batch(items);
+    auto const actual = convert_batch(pool, items);
+    check::that(actual.size() == expected.size());
+    for (std::size_t i{}; i != items.size(); ++i) {
+        check::that(actual[i].status == expected[i].status);
+        check::equal(actual[i].value, expected[i].value);
+    }
+    check::that(convert_batch(pool, std::span<batch_item const>{}).empty());
+
+    return check::result();
+}
@@ -0,0 +1,70 @@
+#include "base_conversion.hpp"
+#include "base_conversion/big_number.hpp"
+#include "base_conversion/fixed.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+auto to_decimal(base from, std::string_view str) -> std::string {
+    std::string result;
+    convert_to_decimal(from, str,
+                       [&](std::string_view chunk) { result += chunk; });
+    return result;
+}
+} // namespace
+
+auto main() -> int {
+    for (int round{}; round != 500; ++round) {
+        auto hexadecimal = inputs::digits("0123456789abcdefABCDEF", 16);
+        hexadecimal.replace(0, inputs::engine() % 17,
+                            std::string(inputs::engine() % 17, '0'));
+        hexadecimal.resize(16, '0');
+        check::equal(hexadecimal_to_decimal<16>(hexadecimal).view(),
+                     hexadecimal_to_decimal(hexadecimal));
+        check::equal(hexadecimal_to_binary<16>(hexadecimal).view(),
+                     hexadecimal_to_binary(hexadecimal));
+
+        auto const wide = inputs::digits("0123456789abcdef", 32);
+        check::equal(hexadecimal_to_decimal<32>(wide).view(),
+                     to_decimal(base::hexadecimal, wide));
+
+        auto const binary = inputs::digits("01", 64);
+        check::equal(binary_to_hexadecimal<64>(binary).view(),
+                     binary_to_hexadecimal(binary));
+        check::equal(binary_to_decimal<64>(binary).view(),
+                     binary_to_decimal(binary));
+
+        auto const short_binary = inputs::digits("01", 7);
+        check::equal(binary_to_hexadecimal<7>(short_binary).view(),
+                     binary_to_hexadecimal(short_binary));
+
+        auto const long_binary = inputs::digits("01", 128);
+        check::equal(binary_to_decimal<128>(long_binary).view(),
+                     to_decimal(base::binary, long_binary));
+        check::equal(binary_to_hexadecimal<128>(long_binary).view(),
+                     binary_to_hexadecimal(long_binary));
+    }
+
+    check::equal(
+        hexadecimal_to_decimal<32>("ffffffffffffffffffffffffffffffff").view(),
+        "340282366920938463463374607431768211455");
+    check::equal(hexadecimal_to_decimal<16>("0000000000000000").view(), "0");
+    check::equal(std::string_view(binary_to_hexadecimal<4>("0000")), "0");
+
+    check::throws<std::invalid_argument>(
+        [] { hexadecimal_to_decimal<16>("123"); });
+    check::equal(check::throws<std::invalid_argument>(
+                     [] { hexadecimal_to_decimal<16>("000000000000000g"); }),
+                 "base conversion error: invalid character 'g' in string");
+    check::throws<std::invalid_argument>(
+        [] { binary_to_hexadecimal<8>("00000002"); });
+
+    return check::result();
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+// Reproducible random inputs for the tests; every executable starts from the
+// same seed.
+namespace inputs {
+inline std::mt19937_64 engine(90);
+
+inline auto digits(std::string_view alphabet, std::size_t length)
+    -> std::string {
+    std::string result(length, '0');
+    for (auto &ch : result) {
+        ch = alphabet[engine() % alphabet.size()];
+    }
+    return result;
+}
+
+// Spread over all bit widths rather than mostly 64-bit values.
+inline auto value() -> std::uint64_t { return engine() >> (engine() % 64); }
+
+inline auto trimmed(std::string_view str) -> std::string {
+    auto const pos = str.find_first_not_of('0');
+    return pos == std::string_view::npos ? "0" : std::string(str.substr(pos));
+}
+} // namespace inputs
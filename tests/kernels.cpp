@@ -0,0 +1,172 @@
+#include "base_conversion.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+// The string-map kernels that the lookup tables replaced, kept as the
+// reference the table kernels must agree with, errors included.
+namespace legacy {
+auto trim(std::string_view str) -> std::string_view {
+    if (str.empty()) {
+        throw std::invalid_argument("base conversion error: string is empty");
+    }
+    auto const pos = str.find_first_not_of('0');
+    return pos == std::string_view::npos ? "0" : str.substr(pos);
+}
+
+auto pad(std::string_view str, std::size_t multiple) -> std::string {
+    std::string result(str);
+    result.insert(0, (multiple - result.size() % multiple) % multiple, '0');
+    return result;
+}
+
+auto invalid(char ch) -> void {
+    throw std::invalid_argument(
+        std::string("base conversion error: invalid character '") + ch +
+        "' in string");
+}
+
+auto validate(std::string_view str, std::string_view valid) -> void {
+    for (auto &&ch : str) {
+        if (valid.find(ch) == std::string_view::npos) {
+            invalid(ch);
+        }
+    }
+}
+
+constexpr std::array<std::string_view, 16> nibbles{
+    "0000", "0001", "0010", "0011", "0100", "0101", "0110", "0111",
+    "1000", "1001", "1010", "1011", "1100", "1101", "1110", "1111"};
+
+auto group_to_digit(std::string_view group) -> char {
+    auto const padded = pad(group, 4);
+    for (std::size_t i{}; i != nibbles.size(); ++i) {
+        if (padded == nibbles[i]) {
+            return "0123456789ABCDEF"[i];
+        }
+    }
+    return '?';
+}
+
+auto digit_to_group(char digit, std::size_t bits) -> std::string_view {
+    auto const value = std::string_view("0123456789abcdef")
+                           .find(static_cast<char>(digit | 0x20));
+    return nibbles[value].substr(4 - bits);
+}
+
+auto from_binary(std::string_view str, std::size_t bits) -> std::string {
+    validate(str, "01");
+    auto const padded = pad(trim(str), bits);
+    std::string result;
+    for (std::size_t i{}; i != padded.size(); i += bits) {
+        result += group_to_digit(std::string_view(padded).substr(i, bits));
+    }
+    return std::string(trim(result));
+}
+
+auto to_binary(std::string_view str, std::string_view valid,
+               std::size_t bits) -> std::string {
+    std::string result;
+    for (auto &&ch : trim(str)) {
+        validate(std::string_view(&ch, 1), valid);
+        result += digit_to_group(ch, bits);
+    }
+    return std::string(trim(result));
+}
+
+auto binary_to_octal(std::string_view str) -> std::string {
+    return from_binary(str, 3);
+}
+
+auto binary_to_hexadecimal(std::string_view str) -> std::string {
+    return from_binary(str, 4);
+}
+
+auto octal_to_binary(std::string_view str) -> std::string {
+    return to_binary(str, "01234567", 3);
+}
+
+auto hexadecimal_to_binary(std::string_view str) -> std::string {
+    return to_binary(str, "0123456789ABCDEFabcdef", 4);
+}
+} // namespace legacy
+
+namespace {
+using kernel = auto (*)(std::string_view) -> std::string;
+
+// The result, or the error message prefixed with '!'.
+auto outcome(kernel convert, std::string_view str) -> std::string {
+    try {
+        return convert(str);
+    } catch (std::invalid_argument const &e) {
+        return std::string("!") + e.what();
+    }
+}
+
+struct kernel_pair {
+    char const *name;
+    kernel table;
+    kernel map;
+    std::string_view digits;
+};
+
+auto agree(kernel_pair const &k, std::string_view str) -> void {
+    auto const expected = outcome(k.map, str);
+    auto const actual = outcome(k.table, str);
+    if (actual != expected) {
+        check::fail(std::string(k.name) + "(\"" + std::string(str) +
+                        "\"): got \"" + actual + "\", expected \"" +
+                        expected + "\"",
+                    std::source_location::current());
+    }
+}
+} // namespace
+
+auto main() -> int {
+    kernel_pair const kernels[]{
+        {"binary_to_octal",
+         [](std::string_view str) { return binary_to_octal(str); },
+         legacy::binary_to_octal, "01"},
+        {"binary_to_hexadecimal",
+         [](std::string_view str) { return binary_to_hexadecimal(str); },
+         legacy::binary_to_hexadecimal, "01"},
+        {"octal_to_binary",
+         [](std::string_view str) { return octal_to_binary(str); },
+         legacy::octal_to_binary, "01234567"},
+        {"hexadecimal_to_binary",
+         [](std::string_view str) { return hexadecimal_to_binary(str); },
+         legacy::hexadecimal_to_binary, "0123456789ABCDEFabcdef"},
+    };
+
+    for (auto const &k : kernels) {
+        for (std::string_view str : {"", "0", "00000000000", "1", "01"}) {
+            agree(k, str);
+        }
+
+        for (std::size_t length = 1; length <= 70; ++length) {
+            for (int round{}; round != 20; ++round) {
+                auto const str = std::string(inputs::engine() % 12, '0') +
+                                 inputs::digits(k.digits, length);
+                agree(k, str);
+
+                // A character that is usually not a digit, anywhere
+                // including the leading zeros.
+                auto bad = str;
+                bad[inputs::engine() % bad.size()] =
+                    "289Gg-x "[inputs::engine() % 8];
+                agree(k, bad);
+            }
+        }
+    }
+
+    return check::result();
+}
@@ -0,0 +1,35 @@
+#include "base_conversion.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "check.hpp"
+
+#ifndef EVQOVV_BASE_CONVERSION_SEPARATE_COMPILATION
+#error "this test must see the declarations only"
+#endif
+
+using namespace evqovv::base_conversion;
+
+// Every conversion resolves to its definition in base_conversion_kernels,
+// both decimal_to_hexadecimal instantiations included.
+auto main() -> int {
+    check::equal(zero_padding("101", 8), "00000101");
+    check::equal(binary_to_octal("111101"), "75");
+    check::equal(binary_to_decimal("111101"), "61");
+    check::equal(binary_to_hexadecimal("111101"), "3D");
+    check::equal(octal_to_binary("75"), "111101");
+    check::equal(octal_to_decimal("75"), "61");
+    check::equal(octal_to_hexadecimal("75"), "3D");
+    check::equal(decimal_to_binary("61"), "111101");
+    check::equal(decimal_to_octal("61"), "75");
+    check::equal(decimal_to_hexadecimal("61"), "3D");
+    check::equal(decimal_to_hexadecimal<false>("61"), "3d");
+    check::equal(hexadecimal_to_binary("3d"), "111101");
+    check::equal(hexadecimal_to_octal("3d"), "75");
+    check::equal(hexadecimal_to_decimal("3d"), "61");
+    check::equal(convert(base::hexadecimal, base::hexadecimal, "3d"), "3D");
+    check::throws<std::invalid_argument>([] { binary_to_octal("2"); });
+
+    return check::result();
+}
@@ -0,0 +1,82 @@
+#ifndef EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+#define EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+#endif
+
+#include "base_conversion.hpp"
+#include "base_conversion/metrics.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "check.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+auto hexadecimal_counters() -> metrics::function_counters {
+    return metrics::take_snapshot().functions[static_cast<std::size_t>(
+        metrics::function_id::binary_to_hexadecimal)];
+}
+} // namespace
+
+auto main() -> int {
+    using metrics::latency_bucket_count;
+    using metrics::latency_bucket_index;
+    using metrics::latency_bucket_lower_bound;
+
+    // Every bucket starts where the previous one ends, and each value lands
+    // in the bucket whose range holds it.
+    check::that(latency_bucket_lower_bound(0) == 0);
+    for (std::size_t b = 1; b != latency_bucket_count; ++b) {
+        check::that(latency_bucket_lower_bound(b) >
+                    latency_bucket_lower_bound(b - 1));
+        check::that(latency_bucket_index(latency_bucket_lower_bound(b)) == b);
+        check::that(latency_bucket_index(latency_bucket_lower_bound(b) - 1) ==
+                    b - 1);
+    }
+    check::that(latency_bucket_index(~std::uint64_t{}) ==
+                latency_bucket_count - 1);
+
+    metrics::function_counters synthetic{};
+    check::that(metrics::latency_quantile(synthetic, 0.5) == 0);
+    synthetic.latency_samples = 100;
+    synthetic.latency_ticks[latency_bucket_index(3)] = 90;
+    synthetic.latency_ticks[latency_bucket_index(1000)] = 10;
+    check::that(metrics::latency_quantile(synthetic, 0.5) == 3);
+    auto const p99 = metrics::latency_quantile(synthetic, 0.99);
+    check::that(p99 >= 900 && p99 <= 1100);
+
+    // With an interval of 1 every call is timed, in new threads too; with 0
+    // none is.
+    metrics::set_latency_sample_interval(1);
+    auto const before = hexadecimal_counters();
+    std::thread([] {
+        for (int i{}; i != 100; ++i) {
+            binary_to_hexadecimal(std::string(1000, '1'));
+        }
+    }).join();
+    auto const sampled = hexadecimal_counters();
+    check::that(sampled.latency_samples - before.latency_samples == 100);
+    check::that(sampled.latency_ticks_sum > before.latency_ticks_sum);
+
+    metrics::set_latency_sample_interval(0);
+    std::thread([] {
+        for (int i{}; i != 100; ++i) {
+            binary_to_hexadecimal("1");
+        }
+    }).join();
+    auto const unsampled = hexadecimal_counters();
+    check::that(unsampled.latency_samples == sampled.latency_samples);
+    check::that(unsampled.calls - sampled.calls == 100);
+
+    check::that(metrics::take_snapshot().ticks_per_second > 0);
+
+    auto const text = metrics::to_prometheus(metrics::take_snapshot());
+    check::that(text.find("evqovv_base_conversion_latency_seconds{function="
+                          "\"binary_to_hexadecimal\",quantile=\"0.5\"}") !=
+                std::string::npos);
+
+    return check::result();
+}
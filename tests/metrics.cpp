@@ -0,0 +1,117 @@
+#ifndef EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+#define EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+#endif
+
+#include "base_conversion.hpp"
+#include "base_conversion/metrics.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "check.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+auto counters(metrics::snapshot const &snap, metrics::function_id id)
+    -> metrics::function_counters const & {
+    return snap.functions[static_cast<std::size_t>(id)];
+}
+
+auto errors(metrics::snapshot const &snap, metrics::function_id id,
+            metrics::error_kind kind) -> std::uint64_t {
+    return counters(snap, id).errors[static_cast<std::size_t>(kind)];
+}
+} // namespace
+
+auto main() -> int {
+    using metrics::error_kind;
+    using metrics::function_id;
+
+    auto const before = metrics::take_snapshot();
+
+    check::equal(binary_to_hexadecimal("10100101"), "A5");
+    check::equal(binary_to_hexadecimal("1"), "1");
+    check::equal(decimal_to_octal("64"), "100");
+    check::throws<std::invalid_argument>([] { octal_to_binary("19"); });
+    check::throws<std::invalid_argument>([] { octal_to_binary(""); });
+    check::throws<std::overflow_error>(
+        [] { decimal_to_binary("18446744073709551616"); });
+
+    // Calls made by threads that have since exited are kept.
+    std::thread([] {
+        for (int i{}; i != 10; ++i) {
+            binary_to_hexadecimal("1111");
+        }
+    }).join();
+
+    // The conversions a fallback path is built on are not counted as
+    // calls of their own.
+    check::equal(octal_to_hexadecimal("17"), "F");
+    check::equal(hexadecimal_to_octal("F"), "17");
+
+    auto const after = metrics::take_snapshot();
+    auto const delta = [&](function_id id, auto field) {
+        return counters(after, id).*field - counters(before, id).*field;
+    };
+
+    using counters_type = metrics::function_counters;
+    check::that(delta(function_id::binary_to_hexadecimal,
+                      &counters_type::calls) == 12);
+    check::that(delta(function_id::binary_to_hexadecimal,
+                      &counters_type::bytes_in) == 8 + 1 + 40);
+    check::that(delta(function_id::binary_to_hexadecimal,
+                      &counters_type::bytes_out) == 2 + 1 + 10);
+    check::that(delta(function_id::decimal_to_octal, &counters_type::calls) ==
+                1);
+    check::that(delta(function_id::octal_to_binary, &counters_type::calls) ==
+                2);
+    check::that(delta(function_id::octal_to_hexadecimal,
+                      &counters_type::calls) == 1);
+    check::that(delta(function_id::hexadecimal_to_octal,
+                      &counters_type::calls) == 1);
+    check::that(delta(function_id::hexadecimal_to_binary,
+                      &counters_type::calls) == 0);
+
+    // Length buckets: "10100101" has bit width 4, "1" 1 and "1111" 3.
+    auto const length_delta = [&](std::size_t bucket) {
+        return counters(after, function_id::binary_to_hexadecimal)
+                   .input_lengths[bucket] -
+               counters(before, function_id::binary_to_hexadecimal)
+                   .input_lengths[bucket];
+    };
+    check::that(length_delta(std::bit_width(8u)) == 1);
+    check::that(length_delta(std::bit_width(1u)) == 1);
+    check::that(length_delta(std::bit_width(4u)) == 10);
+
+    check::that(errors(after, function_id::octal_to_binary,
+                       error_kind::invalid_character) -
+                    errors(before, function_id::octal_to_binary,
+                           error_kind::invalid_character) ==
+                1);
+    check::that(errors(after, function_id::octal_to_binary,
+                       error_kind::empty_string) -
+                    errors(before, function_id::octal_to_binary,
+                           error_kind::empty_string) ==
+                1);
+    check::that(errors(after, function_id::decimal_to_binary,
+                       error_kind::overflow) -
+                    errors(before, function_id::decimal_to_binary,
+                           error_kind::overflow) ==
+                1);
+
+    auto const text = metrics::to_prometheus(after);
+    auto const calls = counters(after, function_id::decimal_to_octal).calls;
+    check::that(text.find("evqovv_base_conversion_calls_total{function="
+                          "\"decimal_to_octal\"} " +
+                          std::to_string(calls) + "\n") != std::string::npos);
+    check::that(text.find("evqovv_base_conversion_errors_total{function="
+                          "\"octal_to_binary\",kind=\"invalid_character\"}") !=
+                std::string::npos);
+
+    return check::result();
+}
@@ -0,0 +1,23 @@
+import evqovv.base_conversion;
+
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+
+using namespace evqovv::base_conversion;
+
+// The exported names are usable through the module alone.
+auto main() -> int {
+    check::equal(convert(base::binary, base::hexadecimal, "111101"), "3D");
+    check::equal(decimal_to_hexadecimal<false>("61"), "3d");
+    check::equal(zero_padding("1", 3), "001");
+
+    char out[8];
+    auto const result = convert_into(base::octal, base::decimal, "75", out);
+    check::that(result.ec == conversion_errc::ok);
+    check::equal(std::string_view(out, result.size), "61");
+    check::that(max_output_size(base::octal, base::binary, 2) == 6);
+
+    return check::result();
+}
@@ -0,0 +1,108 @@
+#include "base_conversion/parallel.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+constexpr base power_of_two_bases[]{base::binary, base::octal,
+                                    base::hexadecimal};
+
+auto alphabet_of(base b) -> std::string_view {
+    switch (b) {
+    case base::binary:
+        return "01";
+    case base::octal:
+        return "01234567";
+    default:
+        return "0123456789abcdefABCDEF";
+    }
+}
+} // namespace
+
+auto main() -> int {
+    using details::parallel_chunk_digits;
+    using details::transcode_parallel;
+
+    thread_pool pool(3);
+    inline_executor serial;
+
+    // Every split gives convert()'s result: a single chunk, a partial first
+    // chunk, leading zeros covering whole chunks, more tasks than chunks.
+    for (auto from : power_of_two_bases) {
+        for (auto to : power_of_two_bases) {
+            if (from == to) {
+                continue;
+            }
+            for (auto length : {std::size_t{1}, parallel_chunk_digits + 5,
+                                3 * parallel_chunk_digits - 1}) {
+                auto str = std::string(length % 3 == 2 ? parallel_chunk_digits
+                                                       : 2,
+                                       '0') +
+                           inputs::digits(alphabet_of(from), length);
+                str.insert(str.size() / 2, 1000, '0');
+                auto const expected = convert(from, to, str);
+
+                for (unsigned threads : {0u, 1u, 2u, 16u}) {
+                    check::equal(transcode_parallel(pool, from, to, str,
+                                                    {.threads = threads}, {}),
+                                 expected);
+                }
+                check::equal(transcode_parallel(serial, from, to, str, {}, {}),
+                             expected);
+                check::equal(transcode_parallel(pool, from, to, str,
+                                                {.numa_pinning = true}, {}),
+                             expected);
+            }
+        }
+    }
+
+    // The character reported is the first invalid one, even when a later
+    // chunk also holds one and finishes first.
+    auto bad = inputs::digits("01", 4 * parallel_chunk_digits);
+    bad[parallel_chunk_digits + 3] = '2';
+    bad[3 * parallel_chunk_digits] = 'x';
+    auto const expected = check::throws<std::invalid_argument>(
+        [&] { convert(base::binary, base::hexadecimal, bad); });
+    for (int round{}; round != 5; ++round) {
+        check::equal(check::throws<std::invalid_argument>([&] {
+                         transcode_parallel(pool, base::binary,
+                                            base::hexadecimal, bad, {}, {});
+                     }),
+                     expected);
+    }
+    check::throws<std::invalid_argument>([&] {
+        transcode_parallel(pool, base::binary, base::octal, "0002", {}, {});
+    });
+
+    std::stop_source source;
+    source.request_stop();
+    check::throws<conversion_cancelled>([&] {
+        transcode_parallel(pool, base::binary, base::octal,
+                           std::string(2 * parallel_chunk_digits, '1'), {},
+                           source.get_token());
+    });
+
+    // convert_parallel() keeps short inputs, decimal and same-base
+    // conversions on the calling thread, with the same results.
+    check::equal(convert_parallel(pool, base::hexadecimal, base::binary, "f"),
+                 "1111");
+    check::equal(convert_parallel(base::decimal, base::hexadecimal, "255"),
+                 "FF");
+    check::equal(
+        convert_parallel(pool, base::hexadecimal, base::hexadecimal, "0af"),
+        "AF");
+    check::throws<conversion_cancelled>([&] {
+        convert_parallel(pool, base::binary, base::octal, "1", {},
+                         source.get_token());
+    });
+
+    return check::result();
+}
@@ -0,0 +1,51 @@
+#ifndef EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+#define EVQOVV_BASE_CONVERSION_ENABLE_METRICS
+#endif
+#ifndef EVQOVV_BASE_CONVERSION_ENABLE_USDT
+#define EVQOVV_BASE_CONVERSION_ENABLE_USDT
+#endif
+
+#include "base_conversion.hpp"
+#include "base_conversion/metrics.hpp"
+#include "base_conversion/tracepoints.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "check.hpp"
+
+using namespace evqovv::base_conversion;
+
+auto main() -> int {
+#if __has_include(<sys/sdt.h>)
+    // Another provider in the same translation unit must still link.
+    DTRACE_PROBE(evqovv_base_conversion_test, start);
+#ifdef _SDT_HAS_SEMAPHORES
+    check::that(!tracepoints::details::enabled());
+#else
+    check::that(tracepoints::details::enabled());
+#endif
+#else
+    check::that(!tracepoints::details::enabled());
+#endif
+
+    auto const id = static_cast<std::size_t>(
+        instrumentation::function_id::hexadecimal_to_decimal);
+    auto const kind =
+        static_cast<std::size_t>(instrumentation::error_kind::overflow);
+    auto const before = metrics::take_snapshot().functions[id];
+
+    // Probed calls return and throw as unprobed ones do, and errors are
+    // still attributed with USDT on next to metrics.
+    check::equal(hexadecimal_to_decimal("ff"), "255");
+    check::equal(octal_to_hexadecimal("777"), "1FF");
+    check::throws<std::overflow_error>(
+        [] { hexadecimal_to_decimal("10000000000000000"); });
+    check::throws<std::invalid_argument>([] { binary_to_octal("102"); });
+
+    auto const after = metrics::take_snapshot().functions[id];
+    check::that(after.calls - before.calls == 2);
+    check::that(after.errors[kind] - before.errors[kind] == 1);
+
+    return check::result();
+}
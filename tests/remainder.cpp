@@ -0,0 +1,67 @@
+#include "base_conversion/remainder.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+auto main() -> int {
+    struct radix_digits {
+        base radix;
+        unsigned value;
+        std::string_view digits;
+    };
+    radix_digits const radixes[]{
+        {base::binary, 2, "01"},
+        {base::octal, 8, "01234567"},
+        {base::decimal, 10, "0123456789"},
+        {base::hexadecimal, 16, "0123456789abcdefABCDEF"},
+    };
+
+    for (auto const &[radix, value, digits] : radixes) {
+        for (int round{}; round != 20; ++round) {
+            for (std::uint64_t modulus :
+                 {std::uint64_t{1}, std::uint64_t{97}, std::uint64_t{1} << 63,
+                  std::numeric_limits<std::uint64_t>::max(),
+                  inputs::value() | 1}) {
+                auto const str =
+                    inputs::digits(digits, 1 + inputs::engine() % 300);
+
+                // Digit by digit, one division each.
+                details::uint128 expected{};
+                for (auto &&ch : str) {
+                    expected = (expected * value +
+                                static_cast<unsigned>(
+                                    details::digit_value(radix, ch))) %
+                               modulus;
+                }
+                check::that(remainder(radix, str, modulus) == expected);
+
+                std::string_view const strs[]{str, "0", "1"};
+                auto const batch = remainders(radix, strs, modulus);
+                check::that(batch.size() == 3 && batch[0] == expected &&
+                            batch[1] == 0 && batch[2] == 1 % modulus);
+            }
+        }
+    }
+
+    // An IBAN with its check digits is 1 modulo 97.
+    check::that(
+        remainder(base::decimal, "3214282912345698765432161182", 97) == 1);
+
+    check::throws<std::invalid_argument>(
+        [] { remainder(base::decimal, "12", 0); });
+    check::throws<std::invalid_argument>(
+        [] { modular_reducer reducer(0); });
+    check::throws<std::invalid_argument>(
+        [] { remainder(base::octal, "128", 5); });
+    check::throws<std::invalid_argument>(
+        [] { remainder(base::binary, "", 5); });
+
+    return check::result();
+}
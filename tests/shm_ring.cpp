@@ -0,0 +1,245 @@
+#include "base_conversion/shm_ring.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+auto const ring_name = "/base_conversion_test_" + std::to_string(::getpid());
+
+// A second mapping of the segment, for writing the raw requests a
+// misbehaving or dying client would leave behind.
+class raw_segment {
+public:
+    raw_segment() {
+        auto const fd = ::shm_open(ring_name.c_str(), O_RDWR, 0);
+        struct stat info {};
+        ::fstat(fd, &info);
+        size_ = static_cast<std::size_t>(info.st_size);
+        base_ = static_cast<char *>(::mmap(nullptr, size_,
+                                           PROT_READ | PROT_WRITE, MAP_SHARED,
+                                           fd, 0));
+        ::close(fd);
+    }
+
+    raw_segment(raw_segment const &) = delete;
+    auto operator=(raw_segment const &) -> raw_segment & = delete;
+
+    ~raw_segment() { ::munmap(base_, size_); }
+
+    auto header() const -> shm::details::segment_header & {
+        return *reinterpret_cast<shm::details::segment_header *>(base_);
+    }
+
+    // Claims the next position, as ring::convert() does, and writes a
+    // request into its slot without publishing it.
+    auto claim(std::uint32_t from, std::uint32_t to, std::string_view input,
+               std::uint32_t size) -> std::uint32_t {
+        auto const position = static_cast<std::uint32_t>(
+            header().tail.fetch_add(1, std::memory_order_relaxed));
+        auto &request = slot(position);
+        auto const pid = static_cast<std::int32_t>(::getpid());
+        request.owner.store(shm::details::make_owner(position, pid),
+                            std::memory_order_relaxed);
+        std::memcpy(&request.from, &from, 1);
+        std::memcpy(&request.to, &to, 1);
+        request.size = size;
+        std::memcpy(reinterpret_cast<char *>(&request + 1), input.data(),
+                    input.size());
+        return position;
+    }
+
+    auto slot(std::uint32_t position) const -> shm::details::slot_header & {
+        auto const index = position & (header().slot_count - 1);
+        return *reinterpret_cast<shm::details::slot_header *>(
+            base_ + sizeof(shm::details::segment_header) +
+            index * shm::details::slot_stride(header().slot_bytes));
+    }
+
+    auto wait_for(std::uint32_t position, std::uint32_t sequence) const
+        -> void {
+        while (slot(position).sequence.load() != sequence) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    char *base_{};
+    std::size_t size_{};
+};
+
+// The process id of a process that has exited.
+auto dead_pid() -> std::int32_t {
+    auto const pid = ::fork();
+    if (pid == 0) {
+        ::_exit(0);
+    }
+    ::waitpid(pid, nullptr, 0);
+    return pid;
+}
+
+// Serves `ring` on a thread for the lifetime of the object.
+class worker {
+public:
+    explicit worker(shm::ring &ring)
+        : ring_(ring), thread_([this] { ring_.serve(stop_); }) {}
+
+    ~worker() {
+        stop_.store(true);
+        ring_.wake_worker();
+        thread_.join();
+    }
+
+private:
+    shm::ring &ring_;
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+} // namespace
+
+auto main() -> int {
+    check::throws<std::invalid_argument>(
+        [] { shm::ring::create(ring_name, 6); });
+    check::throws<std::system_error>([] { shm::ring::attach(ring_name); });
+
+    // Many client threads share a small ring, each through its own mapping;
+    // results and errors come back as convert() would produce them.
+    {
+        auto ring = shm::ring::create(ring_name, 4, 128);
+        worker serving(ring);
+
+        std::vector<std::string> inputs;
+        for (int i{}; i != 256; ++i) {
+            inputs.push_back(inputs::digits("0123456789abcdef", 1 + i % 16));
+        }
+
+        std::vector<int> wrong(4);
+        std::vector<std::thread> clients;
+        for (std::size_t t{}; t != wrong.size(); ++t) {
+            clients.emplace_back([&, t] {
+                auto client = shm::ring::attach(ring_name);
+                for (std::size_t i = t; i < inputs.size(); i += wrong.size()) {
+                    if (client.convert(base::hexadecimal, base::decimal,
+                                       inputs[i]) !=
+                        hexadecimal_to_decimal(inputs[i])) {
+                        ++wrong[t];
+                    }
+                }
+            });
+        }
+        for (auto &client : clients) {
+            client.join();
+        }
+        for (auto count : wrong) {
+            check::that(count == 0);
+        }
+
+        check::equal(ring.convert(base::hexadecimal, base::hexadecimal, "0ff"),
+                     "FF");
+        check::throws<std::invalid_argument>(
+            [&] { ring.convert(base::binary, base::decimal, "2"); });
+        check::throws<std::overflow_error>([&] {
+            ring.convert(base::hexadecimal, base::decimal,
+                         "10000000000000000");
+        });
+        check::throws<std::length_error>([&] {
+            ring.convert(base::hexadecimal, base::binary, std::string(40, 'f'));
+        });
+        check::throws<std::invalid_argument>([&] {
+            ring.convert(base::binary, base::octal, std::string(129, '1'));
+        });
+
+        // Requests written past the slot or naming an unknown base are
+        // answered with invalid_argument instead of being converted.
+        raw_segment raw;
+        auto const slot_count = raw.header().slot_count;
+        auto const answer = [&](std::uint32_t from, std::uint32_t to,
+                                std::uint32_t size) {
+            auto const position = raw.claim(from, to, "101", size);
+            shm::details::publish(raw.slot(position).sequence, position + 1,
+                                  raw.header().worker_waiting);
+            raw.wait_for(position, position + 2);
+            auto &slot = raw.slot(position);
+            auto const result = slot.result;
+            auto const message = std::string(
+                reinterpret_cast<char const *>(&slot + 1), slot.size);
+            slot.owner.store(0);
+            shm::details::publish(slot.sequence, position + slot_count,
+                                  slot.client_waiting);
+            return std::pair(result, message);
+        };
+        check::that(answer(0, 3, 3) == std::pair(shm::status::ok,
+                                                 std::string("5")));
+        check::that(answer(0, 3, 129).first == shm::status::invalid_argument);
+        check::that(answer(4, 3, 3).first == shm::status::invalid_argument);
+        check::that(answer(0, 255, 3).first == shm::status::invalid_argument);
+
+        // A client that died after claiming a slot, before publishing, and
+        // one that died before collecting its result, do not stall the
+        // ring.
+        auto const pid = ::fork();
+        if (pid == 0) {
+            raw_segment child;
+            auto const uncollected = child.claim(0, 1, "111", 3);
+            shm::details::publish(child.slot(uncollected).sequence,
+                                  uncollected + 1,
+                                  child.header().worker_waiting);
+            child.wait_for(uncollected, uncollected + 2);
+            child.claim(0, 1, "111", 3);
+            ::_exit(0);
+        }
+        ::waitpid(pid, nullptr, 0);
+        for (std::uint32_t i{}; i != 2 * slot_count; ++i) {
+            check::equal(ring.convert(base::binary, base::octal, "111"), "7");
+        }
+    }
+    check::throws<std::system_error>([] { shm::ring::attach(ring_name); });
+
+    // Without a worker, or with one that died while holding the request,
+    // the client withdraws after the grace period and the slot is reused.
+    {
+        auto ring = shm::ring::create(ring_name, 4, 64);
+        raw_segment raw;
+
+        auto const message = check::throws<std::runtime_error>(
+            [&] { ring.convert(base::binary, base::octal, "1"); });
+        check::that(message.find("no worker") != std::string::npos);
+
+        raw.header().worker.store(dead_pid());
+        std::thread taker([&] {
+            // Takes the next request the way serve() does, then never
+            // finishes it.
+            raw.wait_for(1, 2);
+            std::uint32_t ready = 2;
+            raw.slot(1).sequence.compare_exchange_strong(ready, 4);
+        });
+        auto const died = check::throws<std::runtime_error>(
+            [&] { ring.convert(base::binary, base::octal, "1"); });
+        taker.join();
+        check::that(died.find("worker died") != std::string::npos);
+        check::that(raw.slot(1).sequence.load() == 1 + 4);
+
+        worker serving(ring);
+        check::equal(ring.convert(base::binary, base::octal, "1000"), "10");
+    }
+
+    return check::result();
+}
@@ -0,0 +1,107 @@
+#include "base_conversion/spill.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+constexpr base power_of_two_bases[]{base::binary, base::octal,
+                                    base::hexadecimal};
+
+auto alphabet_of(base b) -> std::string_view {
+    switch (b) {
+    case base::binary:
+        return "01";
+    case base::octal:
+        return "01234567";
+    default:
+        return "0123456789abcdefABCDEF";
+    }
+}
+} // namespace
+
+auto main() -> int {
+    auto const directory = std::filesystem::temp_directory_path().string();
+
+    // In memory and spilled through a buffer smaller than the output, the
+    // result is convert()'s, same-base hexadecimal in uppercase included.
+    for (auto from : power_of_two_bases) {
+        for (auto to : power_of_two_bases) {
+            for (auto length : {std::size_t{1}, std::size_t{100},
+                                std::size_t{5000}}) {
+                auto str = "00" + inputs::digits(alphabet_of(from), length);
+                str.insert(str.size() / 2, 64, '0');
+                auto const expected = convert(from, to, str);
+
+                auto const in_memory = convert_with_budget(from, to, str);
+                check::that(!in_memory.spilled());
+                check::that(in_memory.native_handle() == -1);
+                check::equal(in_memory.view(), expected);
+
+                auto const spilled = convert_with_budget(
+                    from, to, str,
+                    {.memory_bytes = 7, .spill_directory = directory});
+                check::that(spilled.spilled() == (expected.size() > 7));
+                check::equal(spilled.view(), expected);
+            }
+        }
+    }
+
+    check::equal(convert_with_budget(base::hexadecimal, base::hexadecimal,
+                                     "00aBc", {.memory_bytes = 1,
+                                               .spill_directory = directory})
+                     .view(),
+                 "ABC");
+
+    // Decimal conversions always fit and stay in memory.
+    auto const decimal =
+        convert_with_budget(base::decimal, base::binary, "255",
+                            {.memory_bytes = 1, .spill_directory = directory});
+    check::that(!decimal.spilled());
+    check::equal(decimal.view(), "11111111");
+
+    // Outputs beyond memory plus spill space are refused before any work,
+    // and errors are the ones convert() throws.
+    check::throws<std::length_error>([&] {
+        convert_with_budget(base::hexadecimal, base::binary, "ffff",
+                            {.memory_bytes = 8,
+                             .spill_bytes = 7,
+                             .spill_directory = directory});
+    });
+    check::equal(convert_with_budget(base::hexadecimal, base::binary, "ffff",
+                                     {.memory_bytes = 8,
+                                      .spill_bytes = 8,
+                                      .spill_directory = directory})
+                     .view(),
+                 std::string(16, '1'));
+    check::throws<std::invalid_argument>(
+        [] { convert_with_budget(base::binary, base::octal, ""); });
+    check::throws<std::invalid_argument>(
+        [] { convert_with_budget(base::octal, base::binary, "78"); });
+    check::throws<std::system_error>([&] {
+        convert_with_budget(base::binary, base::octal, std::string(64, '1'),
+                            {.memory_bytes = 1,
+                             .spill_directory = directory + "/missing/dir"});
+    });
+
+    // The mapping moves with the output.
+    auto first = convert_with_budget(
+        base::binary, base::hexadecimal, std::string(64, '1'),
+        {.memory_bytes = 1, .spill_directory = directory});
+    auto second = std::move(first);
+    check::that(second.spilled());
+    check::equal(second.view(), std::string(16, 'F'));
+    first = std::move(second);
+    check::equal(first.view(), std::string(16, 'F'));
+
+    return check::result();
+}
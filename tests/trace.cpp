@@ -0,0 +1,98 @@
+#ifndef EVQOVV_BASE_CONVERSION_ENABLE_TRACE
+#define EVQOVV_BASE_CONVERSION_ENABLE_TRACE
+#endif
+
+#include "base_conversion/parallel.hpp"
+#include "base_conversion/spill.hpp"
+#include "base_conversion/trace.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "check.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+auto count(std::string_view json, std::string_view what) -> std::size_t {
+    std::size_t result{};
+    for (auto pos = json.find(what); pos != std::string_view::npos;
+         pos = json.find(what, pos + what.size())) {
+        ++result;
+    }
+    return result;
+}
+
+auto complete_events(std::string_view json) -> std::size_t {
+    return count(json, "\"ph\":\"X\"");
+}
+
+auto named(std::string_view name) -> std::string {
+    return "\"name\":\"" + std::string(name) + "\"";
+}
+} // namespace
+
+auto main() -> int {
+    thread_pool pool(2);
+    std::string const large(3 * details::parallel_chunk_digits, '1');
+
+    // Nothing is recorded before start().
+    details::transcode_parallel(pool, base::binary, base::hexadecimal, large,
+                                {}, {});
+    check::that(complete_events(trace::to_chrome_json()) == 0);
+
+    // Every phase of a parallel conversion shows up, one chunk span per
+    // chunk, and nothing after stop().
+    trace::start();
+    details::transcode_parallel(pool, base::binary, base::hexadecimal, large,
+                                {}, {});
+    trace::stop();
+    auto const json = trace::to_chrome_json();
+    check::that(
+        json.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    check::that(json.ends_with("]}\n"));
+    check::that(count(json, "{") == count(json, "}"));
+    check::that(count(json, named("prescan")) == 1);
+    check::that(count(json, named("dispatch")) == 1);
+    check::that(count(json, named("task")) >= 1);
+    check::that(count(json, named("chunk")) == 3);
+
+    details::transcode_parallel(pool, base::binary, base::hexadecimal, large,
+                                {}, {});
+    check::that(trace::to_chrome_json() == json);
+
+    // clear() starts over; spilled output records its writes.
+    trace::clear();
+    check::that(complete_events(trace::to_chrome_json()) == 0);
+    trace::start();
+    convert_with_budget(
+        base::binary, base::octal, std::string(300, '1'),
+        {.memory_bytes = 16,
+         .spill_directory = std::filesystem::temp_directory_path().string()});
+    trace::stop();
+    check::that(count(trace::to_chrome_json(), named("spill_write")) >= 2);
+
+    // A thread that records more than its buffer holds counts the rest as
+    // dropped.
+    trace::clear();
+    trace::set_buffer_capacity(2);
+    trace::start();
+    std::thread([] {
+        for (int i{}; i != 5; ++i) {
+            EVQOVV_BASE_CONVERSION_SPAN("test", i);
+        }
+    }).join();
+    trace::stop();
+    auto const dropped = trace::to_chrome_json();
+    check::that(count(dropped, named("test")) == 2);
+    check::that(count(dropped, "\"dropped\":3") == 1);
+
+    // The exited thread's buffer goes with the next clear().
+    trace::clear();
+    check::that(count(trace::to_chrome_json(), "\"dropped\":3") == 0);
+
+    return check::result();
+}
@@ -0,0 +1,97 @@
+#include "base_conversion.hpp"
+#include "base_conversion/tuning.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+using kernel = auto (*)(std::string_view) -> std::string;
+
+// The result, or the error message prefixed with '!'.
+auto outcome(kernel convert, std::string_view str) -> std::string {
+    try {
+        return convert(str);
+    } catch (std::invalid_argument const &e) {
+        return std::string("!") + e.what();
+    }
+}
+
+auto with_threshold(std::size_t min_length, kernel convert,
+                    std::string_view str) -> std::string {
+    auto values = tuning::current();
+    values.direct_transcode_min_length = min_length;
+    tuning::apply(values);
+    return outcome(convert, str);
+}
+
+// The direct regrouping must agree with the path through binary, errors
+// included.
+auto agree(kernel convert, std::string_view str) -> void {
+    auto const through_binary = with_threshold(
+        std::numeric_limits<std::size_t>::max(), convert, str);
+    auto const direct = with_threshold(1, convert, str);
+    if (direct != through_binary) {
+        check::fail("\"" + std::string(str) + "\": got \"" + direct +
+                        "\", expected \"" + through_binary + "\"",
+                    std::source_location::current());
+    }
+}
+} // namespace
+
+auto main() -> int {
+    auto const defaults = tuning::current();
+
+    struct {
+        kernel convert;
+        std::string_view digits;
+    } const kernels[]{
+        {[](std::string_view str) { return hexadecimal_to_octal(str); },
+         "0123456789abcdefABCDEF"},
+        {[](std::string_view str) { return octal_to_hexadecimal(str); },
+         "01234567"},
+    };
+
+    for (auto const &k : kernels) {
+        for (std::string_view str : {"", "0", "00000000000000000000", "1",
+                                     "7", "10000000", "100000000000000000"}) {
+            agree(k.convert, str);
+        }
+
+        // Zero runs of every length at every offset, after leading digits of
+        // every bit width, cover each alignment of the run skip.
+        for (std::size_t prefix = 1; prefix <= 4; ++prefix) {
+            for (std::size_t run = 1; run <= 40; ++run) {
+                for (int round{}; round != 10; ++round) {
+                    auto const str = std::string(inputs::engine() % 3, '0') +
+                                     inputs::digits(k.digits, prefix) +
+                                     std::string(run, '0') +
+                                     inputs::digits(k.digits,
+                                                    inputs::engine() % 10);
+                    agree(k.convert, str);
+
+                    // An invalid character inside, before or after the run.
+                    auto bad = str;
+                    bad[inputs::engine() % bad.size()] =
+                        "89gG-x "[inputs::engine() % 7];
+                    agree(k.convert, bad);
+                }
+            }
+        }
+
+        for (std::size_t length = 1; length <= 200; length += 7) {
+            agree(k.convert, inputs::digits(k.digits, length));
+        }
+    }
+
+    tuning::apply(defaults);
+    return check::result();
+}
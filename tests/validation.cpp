@@ -0,0 +1,142 @@
+#include "base_conversion/validation.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+constexpr base bases[]{base::binary, base::octal, base::decimal,
+                       base::hexadecimal};
+
+auto alphabet_of(base b) -> std::string_view {
+    switch (b) {
+    case base::binary:
+        return "01";
+    case base::octal:
+        return "01234567";
+    case base::decimal:
+        return "0123456789";
+    default:
+        return "0123456789abcdefABCDEF";
+    }
+}
+
+// The answer worked out digit by digit.
+auto reference(base radix, std::string_view str) -> validation_result {
+    validation_result result;
+    if (str.empty()) {
+        result.ec = conversion_errc::empty_string;
+        return result;
+    }
+    for (std::size_t i{}; i != str.size(); ++i) {
+        if (details::digit_value(radix, str[i]) < 0) {
+            result.ec = conversion_errc::invalid_character;
+            result.error_offset = i;
+            return result;
+        }
+    }
+
+    auto const first = str.find_first_not_of('0');
+    auto const digits = first == std::string_view::npos ? std::string_view("0")
+                                                        : str.substr(first);
+    result.significant_digits = digits.size();
+    if (radix == base::decimal) {
+        auto const below = [&](std::string_view max) {
+            return digits.size() < max.size() ||
+                   (digits.size() == max.size() && digits <= max);
+        };
+        result.fits_uint64 = below(details::uint64_max_decimal);
+        result.fits_uint128 = below(details::uint128_max_decimal);
+    } else {
+        auto const bits =
+            (digits.size() - 1) *
+                static_cast<std::size_t>(details::bits_per_digit(radix)) +
+            static_cast<std::size_t>(std::bit_width(static_cast<unsigned>(
+                details::digit_value(radix, digits[0]))));
+        result.fits_uint64 = bits <= 64;
+        result.fits_uint128 = bits <= 128;
+    }
+    return result;
+}
+
+auto same(validation_result const &a, validation_result const &b) -> bool {
+    return a.ec == b.ec && a.error_offset == b.error_offset &&
+           a.significant_digits == b.significant_digits &&
+           a.fits_uint64 == b.fits_uint64 && a.fits_uint128 == b.fits_uint128;
+}
+
+// Feeds `str` in random pieces, empty ones included.
+auto fed_in_pieces(base radix, std::string_view str) -> validation_result {
+    validator checker(radix);
+    while (!str.empty()) {
+        auto const piece = std::min<std::size_t>(inputs::engine() % 20,
+                                                 str.size());
+        checker.feed(str.substr(0, piece));
+        str.remove_prefix(piece);
+    }
+    return checker.finish();
+}
+
+auto agree(base radix, std::string_view str) -> void {
+    auto const expected = reference(radix, str);
+    if (!same(validate(radix, str), expected) ||
+        !same(fed_in_pieces(radix, str), expected)) {
+        check::fail("validation of \"" + std::string(str) + "\" differs",
+                    std::source_location::current());
+    }
+}
+} // namespace
+
+auto main() -> int {
+    for (auto radix : bases) {
+        for (std::string_view str : {"", "0", "00000000000000000000", "1"}) {
+            agree(radix, str);
+        }
+
+        for (std::size_t length = 1; length <= 60; ++length) {
+            for (int round{}; round != 20; ++round) {
+                auto str = std::string(inputs::engine() % 20, '0') +
+                           inputs::digits(alphabet_of(radix), length);
+                agree(radix, str);
+
+                str[inputs::engine() % str.size()] =
+                    "289aAfFgG-x \x80"[inputs::engine() % 13];
+                agree(radix, str);
+            }
+        }
+    }
+
+    // Around the uint64_t and uint128_t limits.
+    for (std::string_view str :
+         {"18446744073709551615", "18446744073709551616",
+          "0018446744073709551615", "99999999999999999999",
+          "340282366920938463463374607431768211455",
+          "340282366920938463463374607431768211456",
+          "1000000000000000000000000000000000000000000"}) {
+        agree(base::decimal, str);
+    }
+    for (std::string_view str :
+         {"ffffffffffffffff", "10000000000000000",
+          "ffffffffffffffffffffffffffffffff",
+          "100000000000000000000000000000000"}) {
+        agree(base::hexadecimal, str);
+    }
+    agree(base::octal, "1777777777777777777777");
+    agree(base::octal, "2000000000000000000000");
+
+    // Nothing after the first invalid character is looked at.
+    validator checker(base::binary);
+    check::that(checker.feed("0101"));
+    check::that(!checker.feed("012"));
+    check::that(!checker.feed("1"));
+    check::that(checker.finish().error_offset == 6);
+
+    return check::result();
+}
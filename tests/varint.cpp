@@ -0,0 +1,115 @@
+#include "base_conversion.hpp"
+#include "base_conversion/varint.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "check.hpp"
+#include "inputs.hpp"
+
+using namespace evqovv::base_conversion;
+
+namespace {
+auto append(base from, std::string_view str) -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> out;
+    append_varint(from, str, out);
+    return out;
+}
+
+auto append_zigzag(base from, std::string_view str)
+    -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> out;
+    append_zigzag_varint(from, str, out);
+    return out;
+}
+} // namespace
+
+auto main() -> int {
+    for (std::uint64_t value :
+         {std::uint64_t{0}, std::uint64_t{127}, std::uint64_t{128},
+          std::uint64_t{16383}, std::uint64_t{16384},
+          std::numeric_limits<std::uint64_t>::max()}) {
+        auto const out = append(base::decimal, std::to_string(value));
+        check::that(out.size() == details::varint_size(value));
+
+        std::span<std::uint8_t const> data(out);
+        check::equal(read_varint(data, base::decimal), std::to_string(value));
+        check::that(data.empty());
+    }
+
+    check::that(append(base::decimal, "300") ==
+                std::vector<std::uint8_t>{0xAC, 0x02});
+    check::that(append(base::hexadecimal, "12C") ==
+                append(base::decimal, "300"));
+    check::that(append_zigzag(base::decimal, "-1") ==
+                std::vector<std::uint8_t>{0x01});
+    check::that(append_zigzag(base::decimal, "1") ==
+                std::vector<std::uint8_t>{0x02});
+    // Other bases are two's complement.
+    check::that(append_zigzag(base::hexadecimal, "FFFFFFFFFFFFFFFF") ==
+                append_zigzag(base::decimal, "-1"));
+
+    std::vector<std::string> values;
+    std::vector<std::string> signed_values;
+    for (int i{}; i != 200; ++i) {
+        values.push_back(std::to_string(inputs::value()));
+        auto const value = static_cast<std::int64_t>(inputs::value() >> 1);
+        signed_values.push_back(std::to_string(i % 2 == 0 ? value : -value));
+    }
+    signed_values.push_back(
+        std::to_string(std::numeric_limits<std::int64_t>::min()));
+    signed_values.push_back(
+        std::to_string(std::numeric_limits<std::int64_t>::max()));
+
+    std::vector<std::string_view> const views(values.begin(), values.end());
+    std::vector<std::string_view> const signed_views(signed_values.begin(),
+                                                     signed_values.end());
+    auto const encoded = encode_varints(base::decimal, views);
+    check::that(decode_varints(encoded, base::decimal) == values);
+    auto const zigzag = encode_zigzag_varints(base::decimal, signed_views);
+    check::that(decode_zigzag_varints(zigzag, base::decimal) == signed_values);
+
+    auto const hexadecimal = decode_varints(encoded, base::hexadecimal);
+    for (std::size_t i{}; i != values.size(); ++i) {
+        check::equal(hexadecimal_to_decimal(hexadecimal[i]), values[i]);
+    }
+
+    check::throws<std::overflow_error>(
+        [] { append(base::decimal, "18446744073709551616"); });
+    check::throws<std::overflow_error>(
+        [] { append_zigzag(base::decimal, "-9223372036854775809"); });
+    check::throws<std::overflow_error>(
+        [] { append_zigzag(base::decimal, "9223372036854775808"); });
+    check::throws<std::overflow_error>(
+        [] { append_zigzag(base::decimal, "18446744073709551615"); });
+    check::throws<std::invalid_argument>([] { append(base::octal, "19"); });
+    check::throws<std::invalid_argument>(
+        [] { append_zigzag(base::decimal, ""); });
+    check::equal(check::throws<std::invalid_argument>(
+                     [] { append_zigzag(base::decimal, "-"); }),
+                 "base conversion error: string is empty");
+    check::throws<std::invalid_argument>([] {
+        std::string_view const strs[]{"1", "-"};
+        encode_zigzag_varints(base::decimal, strs);
+    });
+
+    check::throws<std::invalid_argument>([] {
+        std::vector<std::uint8_t> const truncated{0x80, 0x80};
+        std::span<std::uint8_t const> data(truncated);
+        read_varint(data, base::decimal);
+    });
+    check::throws<std::invalid_argument>([] {
+        std::vector<std::uint8_t> overlong(10, 0xFF);
+        overlong.back() = 0x02;
+        std::span<std::uint8_t const> data(overlong);
+        read_varint(data, base::decimal);
+    });
+
+    return check::result();
+}
@@ -0,0 +1,103 @@
+#include "base_conversion/wire.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+
+using namespace evqovv::base_conversion;
+
+auto main() -> int {
+    // Frames round-trip, and a buffer holding a frame and a half parses the
+    // first one only.
+    std::string buffer;
+    wire::append_request(buffer, 7, base::hexadecimal, base::decimal, "ff");
+    wire::append_request(buffer, 8, base::binary, base::octal, "101");
+    check::that(buffer.size() == 2 * (wire::size_bytes +
+                                      wire::request_header_bytes) + 5);
+
+    wire::request request;
+    std::size_t consumed{};
+    check::that(wire::parse_request(buffer, request, consumed) ==
+                wire::parse_status::complete);
+    check::that(request.id == 7);
+    check::that(request.item.from == base::hexadecimal);
+    check::that(request.item.to == base::decimal);
+    check::equal(request.item.input, "ff");
+
+    auto const rest = std::string_view(buffer).substr(consumed);
+    for (std::size_t cut{}; cut != rest.size(); ++cut) {
+        check::that(wire::parse_request(rest.substr(0, cut), request,
+                                        consumed) ==
+                    wire::parse_status::incomplete);
+    }
+    check::that(wire::parse_request(rest, request, consumed) ==
+                wire::parse_status::complete);
+    check::that(request.id == 8);
+    check::equal(request.item.input, "101");
+
+    std::string responses;
+    wire::append_response(responses, 0xdeadbeef, {batch_status::ok, "255"});
+    wire::append_response(responses, 1,
+                          {batch_status::overflow, "too large"});
+    wire::response response;
+    check::that(wire::parse_response(responses, response, consumed) ==
+                wire::parse_status::complete);
+    check::that(response.id == 0xdeadbeef);
+    check::that(response.status == batch_status::ok);
+    check::equal(response.value, "255");
+    check::that(wire::parse_response(
+                    std::string_view(responses).substr(consumed), response,
+                    consumed) == wire::parse_status::complete);
+    check::that(response.status == batch_status::overflow);
+    check::equal(response.value, "too large");
+
+    // Sizes below the header, above the frame limit, and unknown bases are
+    // malformed; an empty input is a request like any other.
+    auto const frame = [](std::uint32_t size, unsigned char from,
+                          unsigned char to) {
+        std::string out;
+        wire::append_u32(out, size);
+        wire::append_u32(out, 1);
+        out += static_cast<char>(from);
+        out += static_cast<char>(to);
+        return out;
+    };
+    check::that(wire::parse_request(frame(5, 0, 0), request, consumed) ==
+                wire::parse_status::malformed);
+    check::that(wire::parse_request(
+                    frame(wire::max_frame_bytes + 1, 0, 0), request,
+                    consumed) == wire::parse_status::malformed);
+    check::that(wire::parse_request(frame(6, 4, 0), request, consumed) ==
+                wire::parse_status::malformed);
+    check::that(wire::parse_request(frame(6, 0, 4), request, consumed) ==
+                wire::parse_status::malformed);
+    check::that(wire::parse_request(frame(6, 0, 3), request, consumed) ==
+                wire::parse_status::complete);
+    check::that(request.item.input.empty());
+    check::that(wire::parse_response(frame(4, 0, 0), response, consumed) ==
+                wire::parse_status::malformed);
+    check::that(wire::parse_response(frame(wire::max_frame_bytes + 1, 0, 0),
+                                     response, consumed) ==
+                wire::parse_status::malformed);
+
+    // response_fits() admits exactly the inputs whose largest result still
+    // parses as a response.
+    constexpr auto payload =
+        wire::max_frame_bytes - wire::response_header_bytes;
+    check::that(wire::response_fits(base::hexadecimal, base::binary,
+                                    payload / 4));
+    check::that(!wire::response_fits(base::hexadecimal, base::binary,
+                                     payload / 4 + 1));
+    check::that(wire::response_fits(base::hexadecimal, base::hexadecimal,
+                                    wire::max_frame_bytes -
+                                        wire::request_header_bytes));
+    check::that(wire::response_fits(base::binary, base::octal,
+                                    wire::max_frame_bytes));
+    check::that(wire::response_fits(base::decimal, base::binary,
+                                    wire::max_frame_bytes));
+
+    return check::result();
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+// Command-line helpers shared by the tools.
+namespace tools {
+// The whole of `arg` as a decimal count; anything else, trailing junk
+// included, is rejected with a message naming the argument.
+inline auto parse_count(std::string_view arg, std::string_view name)
+    -> std::uint64_t {
+    std::uint64_t value{};
+    auto const *end = arg.data() + arg.size();
+    auto const [ptr, ec] = std::from_chars(arg.data(), end, value);
+    if (arg.empty() || ec != std::errc{} || ptr != end) {
+        throw std::invalid_argument("invalid " + std::string(name) + " '" +
+                                    std::string(arg) + "'");
+    }
+    return value;
+}
+} // namespace tools
@@ -0,0 +1,154 @@
+#include "base_conversion.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+using namespace evqovv::base_conversion;
+
+// Condensed copies of the string-map kernels that the lookup tables
+// replaced, kept as the baseline.
+namespace legacy {
+auto trim(std::string_view str) -> std::string_view {
+    auto const pos = str.find_first_not_of('0');
+    return pos == std::string_view::npos ? "0" : str.substr(pos);
+}
+
+auto pad(std::string_view str, std::size_t multiple) -> std::string {
+    std::string result(str);
+    result.insert(0, (multiple - result.size() % multiple) % multiple, '0');
+    return result;
+}
+
+auto binary_to_hexadecimal_map(std::string_view str) -> char {
+    static constexpr std::array<std::pair<std::string_view, char>, 16> map{
+        {{"0000", '0'}, {"0001", '1'}, {"0010", '2'}, {"0011", '3'},
+         {"0100", '4'}, {"0101", '5'}, {"0110", '6'}, {"0111", '7'},
+         {"1000", '8'}, {"1001", '9'}, {"1010", 'A'}, {"1011", 'B'},
+         {"1100", 'C'}, {"1101", 'D'}, {"1110", 'E'}, {"1111", 'F'}}};
+    for (auto const &[binary, hexadecimal] : map) {
+        if (str == binary) {
+            return hexadecimal;
+        }
+    }
+    return '?';
+}
+
+auto hexadecimal_to_binary_map(char digit) -> std::string_view {
+    static constexpr std::array<std::string_view, 16> map{
+        "0000", "0001", "0010", "0011", "0100", "0101", "0110", "0111",
+        "1000", "1001", "1010", "1011", "1100", "1101", "1110", "1111"};
+    if (digit >= '0' && digit <= '9') {
+        return map[digit - '0'];
+    } else if (digit >= 'A' && digit <= 'F') {
+        return map[digit - 'A' + 10];
+    }
+    return map[digit - 'a' + 10];
+}
+
+auto validate_binary(std::string_view str) -> void {
+    for (auto &&ch : str) {
+        if (ch != '0' && ch != '1') {
+            throw std::invalid_argument("invalid character");
+        }
+    }
+}
+
+auto validate_hexadecimal(char ch) -> void {
+    if (!((ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'F') ||
+          (ch >= 'a' && ch <= 'f'))) {
+        throw std::invalid_argument("invalid character");
+    }
+}
+
+auto binary_to_hexadecimal(std::string_view str) -> std::string {
+    validate_binary(str);
+    auto const padded = pad(trim(str), 4);
+    std::string result;
+    for (std::size_t i{}; i != padded.size(); i += 4) {
+        result += binary_to_hexadecimal_map(
+            std::string_view(padded).substr(i, 4));
+    }
+    return std::string(trim(result));
+}
+
+auto hexadecimal_to_binary(std::string_view str) -> std::string {
+    std::string result;
+    for (auto &&ch : trim(str)) {
+        validate_hexadecimal(ch);
+        result += hexadecimal_to_binary_map(ch);
+    }
+    return std::string(trim(result));
+}
+} // namespace legacy
+
+namespace {
+auto make_input(std::string_view alphabet, std::size_t length)
+    -> std::string {
+    std::string result(length, '0');
+    std::uint64_t state = 0x9e3779b97f4a7c15u;
+    for (auto &ch : result) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        ch = alphabet[(state >> 33) % alphabet.size()];
+    }
+    result[0] = '1';
+    return result;
+}
+
+// Mean seconds per call over at least `minimum` of wall time.
+auto measure(auto (*convert)(std::string_view)->std::string,
+             std::string_view input, std::chrono::milliseconds minimum)
+    -> double {
+    using clock = std::chrono::steady_clock;
+
+    std::size_t calls{};
+    std::size_t volatile sink{};
+    auto const start = clock::now();
+    auto now = start;
+    while (now - start < minimum) {
+        sink = sink + convert(input).size();
+        ++calls;
+        now = clock::now();
+    }
+    return std::chrono::duration<double>(now - start).count() /
+           static_cast<double>(calls);
+}
+
+auto report(char const *name, auto (*before)(std::string_view)->std::string,
+            auto (*after)(std::string_view)->std::string,
+            std::string_view alphabet) -> void {
+    for (std::size_t length : {16u, 256u, 4096u, 65536u, 1u << 20}) {
+        auto const input = make_input(alphabet, length);
+        if (before(input) != after(input)) {
+            std::printf("%s: results differ at length %zu\n", name, length);
+            continue;
+        }
+
+        auto const old_time =
+            measure(before, input, std::chrono::milliseconds(200));
+        auto const new_time =
+            measure(after, input, std::chrono::milliseconds(200));
+        std::printf("%-24s %8zu  %10.1f MB/s  %10.1f MB/s  %6.2fx\n", name,
+                    length, static_cast<double>(length) / old_time / 1e6,
+                    static_cast<double>(length) / new_time / 1e6,
+                    old_time / new_time);
+    }
+}
+} // namespace
+
+auto main() -> int {
+    std::printf("%-24s %8s  %15s  %15s  %7s\n", "kernel", "length", "legacy",
+                "table", "speedup");
+    report("binary_to_hexadecimal", legacy::binary_to_hexadecimal,
+           [](std::string_view str) { return binary_to_hexadecimal(str); },
+           "01");
+    report("hexadecimal_to_binary", legacy::hexadecimal_to_binary,
+           [](std::string_view str) { return hexadecimal_to_binary(str); },
+           "0123456789abcdef");
+}
@@ -0,0 +1,292 @@
+#include "base_conversion/batch.hpp"
+#include "base_conversion/wire.hpp"
+
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace evqovv::base_conversion;
+
+namespace {
+volatile std::sig_atomic_t stop_requested = 0;
+
+// A client with more unsent response bytes than this gets no further
+// requests read or converted until it catches up.
+constexpr std::size_t max_queued_output = std::size_t{4} << 20;
+
+struct connection {
+    int fd{-1};
+    std::string in;
+    std::string out;
+    std::size_t out_offset{};
+    bool closing{};
+    std::uint32_t events{EPOLLIN | EPOLLRDHUP};
+
+    auto queued_output() const noexcept -> std::size_t {
+        return out.size() - out_offset;
+    }
+};
+
+// A request waiting for its response: either an index into the batch, or
+// the refusal to send instead of converting it.
+struct pending {
+    connection *conn;
+    std::uint32_t id;
+    std::size_t item;
+    std::optional<batch_output> refusal;
+};
+
+auto fail(char const *what) -> int {
+    std::fprintf(stderr, "base_conversion_daemon: %s: %s\n", what,
+                 std::strerror(errno));
+    return 1;
+}
+
+auto read_available(connection &conn) -> void {
+    std::array<char, 64 * 1024> buffer;
+    while (true) {
+        auto const n = ::read(conn.fd, buffer.data(), buffer.size());
+        if (n > 0) {
+            conn.in.append(buffer.data(), static_cast<std::size_t>(n));
+        } else if (n == 0) {
+            conn.closing = true;
+            return;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                conn.closing = true;
+            }
+            return;
+        }
+    }
+}
+
+// Returns false when the peer is gone.
+auto flush(connection &conn) -> bool {
+    while (conn.out_offset != conn.out.size()) {
+        auto const n = ::send(conn.fd, conn.out.data() + conn.out_offset,
+                              conn.out.size() - conn.out_offset, MSG_NOSIGNAL);
+        if (n > 0) {
+            conn.out_offset += static_cast<std::size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    conn.out.clear();
+    conn.out_offset = 0;
+    return true;
+}
+
+// Input is watched until the peer hangs up or too much output is queued,
+// output while anything is left to send. A closing connection is only
+// watched for output, so a pending hang-up does not wake the loop again.
+auto watch(int epoll_fd, connection &conn) -> void {
+    auto const queued = conn.queued_output();
+    std::uint32_t events{};
+    if (!conn.closing && queued <= max_queued_output) {
+        events |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (queued != 0) {
+        events |= EPOLLOUT;
+    }
+    if (events == conn.events) {
+        return;
+    }
+
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = conn.fd;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn.fd, &event);
+    conn.events = events;
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <socket-path>\n", argv[0]);
+        return 2;
+    }
+
+    std::signal(SIGINT, [](int) { stop_requested = 1; });
+    std::signal(SIGTERM, [](int) { stop_requested = 1; });
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (std::strlen(argv[1]) >= sizeof(address.sun_path)) {
+        std::fprintf(stderr, "base_conversion_daemon: socket path too long\n");
+        return 2;
+    }
+    std::strcpy(address.sun_path, argv[1]);
+
+    auto const listener =
+        ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        return fail("socket");
+    }
+    ::unlink(argv[1]);
+    if (::bind(listener, reinterpret_cast<sockaddr *>(&address),
+               sizeof(address)) != 0) {
+        return fail("bind");
+    }
+    if (::listen(listener, SOMAXCONN) != 0) {
+        return fail("listen");
+    }
+
+    auto const epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        return fail("epoll_create1");
+    }
+    epoll_event listen_event{};
+    listen_event.events = EPOLLIN;
+    listen_event.data.fd = listener;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listener, &listen_event);
+
+    std::unordered_map<int, std::unique_ptr<connection>> connections;
+    std::array<epoll_event, 256> events;
+    std::vector<connection *> ready;
+    std::vector<batch_item> items;
+    std::vector<pending> owners;
+
+    while (!stop_requested) {
+        auto const count =
+            ::epoll_wait(epoll_fd, events.data(), events.size(), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return fail("epoll_wait");
+        }
+
+        ready.clear();
+        for (auto i = 0; i != count; ++i) {
+            auto const fd = events[i].data.fd;
+            if (fd == listener) {
+                while (true) {
+                    auto const client = ::accept4(
+                        listener, nullptr, nullptr,
+                        SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (client < 0) {
+                        break;
+                    }
+
+                    auto conn = std::make_unique<connection>();
+                    conn->fd = client;
+                    epoll_event event{};
+                    event.events = EPOLLIN | EPOLLRDHUP;
+                    event.data.fd = client;
+                    ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client, &event);
+                    connections.emplace(client, std::move(conn));
+                }
+                continue;
+            }
+
+            auto const it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+
+            auto &conn = *it->second;
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+                read_available(conn);
+            }
+            if (events[i].events & EPOLLERR) {
+                conn.closing = true;
+            }
+            ready.push_back(&conn);
+        }
+
+        // Every complete frame from every readable connection goes into a
+        // single batch before anything is converted.
+        items.clear();
+        owners.clear();
+        std::vector<std::size_t> consumed_by(ready.size());
+        for (decltype(ready.size()) c{}; c != ready.size(); ++c) {
+            auto &conn = *ready[c];
+            // Backpressure: leave the requests buffered until the client
+            // has read enough of its earlier responses. A dead peer is
+            // closed by the flush below.
+            if (!flush(conn) || conn.queued_output() > max_queued_output) {
+                continue;
+            }
+
+            std::size_t offset{};
+            while (true) {
+                wire::request request;
+                std::size_t consumed{};
+                auto const status = wire::parse_request(
+                    std::string_view(conn.in).substr(offset), request,
+                    consumed);
+                if (status == wire::parse_status::incomplete) {
+                    break;
+                }
+                if (status == wire::parse_status::malformed) {
+                    conn.closing = true;
+                    break;
+                }
+
+                auto const &item = request.item;
+                if (wire::response_fits(item.from, item.to,
+                                        item.input.size())) {
+                    owners.push_back({&conn, request.id, items.size(), {}});
+                    items.push_back(item);
+                } else {
+                    owners.push_back(
+                        {&conn, request.id, 0,
+                         batch_output{batch_status::invalid_argument,
+                                      "base conversion error: result may "
+                                      "exceed the maximum frame size"}});
+                }
+                offset += consumed;
+            }
+            consumed_by[c] = offset;
+        }
+
+        auto const results = convert_batch(items);
+        for (auto const &owner : owners) {
+            wire::append_response(owner.conn->out, owner.id,
+                                  owner.refusal ? *owner.refusal
+                                                : results[owner.item]);
+        }
+
+        for (decltype(ready.size()) c{}; c != ready.size(); ++c) {
+            auto &conn = *ready[c];
+            conn.in.erase(0, consumed_by[c]);
+
+            auto const alive = flush(conn);
+            if (!alive || (conn.closing && conn.queued_output() == 0)) {
+                ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn.fd, nullptr);
+                ::close(conn.fd);
+                connections.erase(conn.fd);
+            } else {
+                watch(epoll_fd, conn);
+            }
+        }
+    }
+
+    for (auto const &[fd, conn] : connections) {
+        ::close(fd);
+    }
+    ::close(epoll_fd);
+    ::close(listener);
+    ::unlink(argv[1]);
+}
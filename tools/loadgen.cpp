@@ -0,0 +1,201 @@
+#include "base_conversion/wire.hpp"
+
+#include "arguments.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace evqovv::base_conversion;
+
+namespace {
+struct worker_result {
+    std::uint64_t requests{};
+    std::uint64_t errors{};
+    double round_trip_seconds{};
+    std::uint64_t round_trips{};
+};
+
+auto connect_to(char const *path) -> int {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+
+    auto const fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("socket: ") +
+                                 std::strerror(errno));
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&address),
+                  sizeof(address)) != 0) {
+        auto const error = errno;
+        ::close(fd);
+        throw std::runtime_error(std::string("connect: ") +
+                                 std::strerror(error));
+    }
+    return fd;
+}
+
+auto send_all(int fd, std::string_view data) -> void {
+    while (!data.empty()) {
+        auto const n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (n <= 0) {
+            throw std::runtime_error("send failed");
+        }
+        data.remove_prefix(static_cast<std::size_t>(n));
+    }
+}
+
+// Sends `depth` pipelined hex-to-decimal requests per round trip until the
+// deadline passes.
+auto run_worker(char const *path, unsigned depth, unsigned seed,
+                std::chrono::steady_clock::time_point deadline)
+    -> worker_result {
+    using clock = std::chrono::steady_clock;
+
+    auto const fd = connect_to(path);
+
+    std::vector<std::string> inputs(1024);
+    std::uint64_t state = seed * 0x9e3779b97f4a7c15u + 1;
+    for (auto &input : inputs) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        input = decimal_to_hexadecimal<false>(std::to_string(state));
+    }
+
+    worker_result result;
+    std::string out;
+    std::string in;
+    std::uint32_t next_id{};
+    while (clock::now() < deadline) {
+        auto const start = clock::now();
+
+        out.clear();
+        auto const first_id = next_id;
+        for (unsigned i{}; i != depth; ++i, ++next_id) {
+            wire::append_request(out, next_id, base::hexadecimal,
+                                 base::decimal,
+                                 inputs[next_id % inputs.size()]);
+        }
+        send_all(fd, out);
+
+        unsigned received{};
+        std::size_t offset{};
+        while (received != depth) {
+            wire::response response;
+            std::size_t consumed{};
+            auto const status = wire::parse_response(
+                std::string_view(in).substr(offset), response, consumed);
+            if (status == wire::parse_status::malformed) {
+                throw std::runtime_error("malformed response");
+            }
+            if (status == wire::parse_status::complete) {
+                // Responses come back in request order.
+                if (response.id != first_id + received) {
+                    throw std::runtime_error("response id mismatch");
+                }
+                if (response.status != batch_status::ok) {
+                    ++result.errors;
+                }
+                ++received;
+                offset += consumed;
+                continue;
+            }
+
+            char buffer[64 * 1024];
+            auto const n = ::read(fd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                throw std::runtime_error("connection closed");
+            }
+            in.append(buffer, static_cast<std::size_t>(n));
+        }
+        in.erase(0, offset);
+
+        result.requests += depth;
+        result.round_trip_seconds +=
+            std::chrono::duration<double>(clock::now() - start).count();
+        ++result.round_trips;
+    }
+
+    ::close(fd);
+    return result;
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+    if (argc < 2 || argc > 5) {
+        std::fprintf(stderr,
+                     "usage: %s <socket-path> [connections] [depth] "
+                     "[seconds]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    try {
+        auto const connections =
+            argc > 2 ? tools::parse_count(argv[2], "connections") : 4;
+        auto const depth = static_cast<unsigned>(
+            argc > 3 ? tools::parse_count(argv[3], "depth") : 64);
+        auto const seconds = std::max<std::uint64_t>(
+            argc > 4 ? tools::parse_count(argv[4], "seconds") : 5, 1);
+
+        auto const deadline = std::chrono::steady_clock::now() +
+                              std::chrono::seconds(seconds);
+        std::vector<worker_result> results(connections);
+        std::vector<std::exception_ptr> failures(connections);
+        std::vector<std::thread> workers;
+        for (std::uint64_t i{}; i != connections; ++i) {
+            workers.emplace_back([&, i] {
+                try {
+                    results[i] = run_worker(argv[1], depth,
+                                            static_cast<unsigned>(i), deadline);
+                } catch (...) {
+                    failures[i] = std::current_exception();
+                }
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        for (auto const &failure : failures) {
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+        }
+
+        worker_result total;
+        for (auto const &result : results) {
+            total.requests += result.requests;
+            total.errors += result.errors;
+            total.round_trip_seconds += result.round_trip_seconds;
+            total.round_trips += result.round_trips;
+        }
+
+        std::printf("requests: %llu\nerrors: %llu\nthroughput: %.0f req/s\n"
+                    "mean round trip (%u pipelined): %.2f us\n",
+                    static_cast<unsigned long long>(total.requests),
+                    static_cast<unsigned long long>(total.errors),
+                    static_cast<double>(total.requests) /
+                        static_cast<double>(seconds),
+                    depth,
+                    total.round_trips == 0
+                        ? 0.0
+                        : total.round_trip_seconds * 1e6 /
+                              static_cast<double>(total.round_trips));
+    } catch (std::exception const &e) {
+        std::fprintf(stderr, "base_conversion_loadgen: %s\n", e.what());
+        return 1;
+    }
+}
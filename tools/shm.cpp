@@ -0,0 +1,119 @@
+#include "base_conversion/shm_ring.hpp"
+
+#include "arguments.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sched.h>
+#include <signal.h>
+
+using namespace evqovv::base_conversion;
+
+namespace {
+std::atomic<bool> stop_requested{false};
+shm::ring *served_ring{};
+
+auto serve(std::string const &name, int cpu) -> void {
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (::sched_setaffinity(0, sizeof(set), &set) != 0) {
+            std::perror("sched_setaffinity");
+        }
+    }
+
+    auto ring = shm::ring::create(name);
+    served_ring = &ring;
+
+    // Installed without SA_RESTART so a worker parked in futex_wait on this
+    // thread returns to check the stop flag.
+    struct sigaction action {};
+    action.sa_handler = [](int) {
+        stop_requested.store(true);
+        served_ring->wake_worker();
+    };
+    ::sigaction(SIGINT, &action, nullptr);
+    ::sigaction(SIGTERM, &action, nullptr);
+
+    ring.serve(stop_requested);
+}
+
+// Single-threaded ping-pong of span-id sized hex-to-decimal requests.
+auto bench(std::string const &name, std::uint64_t seconds) -> void {
+    using clock = std::chrono::steady_clock;
+
+    auto ring = shm::ring::attach(name);
+
+    std::vector<std::string> inputs(1024);
+    std::uint64_t state = 0x9e3779b97f4a7c15u;
+    for (auto &input : inputs) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        input = decimal_to_hexadecimal(std::to_string(state));
+    }
+
+    std::vector<double> samples;
+    auto const deadline = clock::now() + std::chrono::seconds(seconds);
+    while (clock::now() < deadline) {
+        auto const &input = inputs[samples.size() % inputs.size()];
+        auto const start = clock::now();
+        ring.convert(base::hexadecimal, base::decimal, input);
+        samples.push_back(
+            std::chrono::duration<double, std::micro>(clock::now() - start)
+                .count());
+    }
+
+    if (samples.empty()) {
+        std::printf("round trips: 0\n");
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto const at = [&](double q) {
+        return samples[static_cast<std::size_t>(
+            q * static_cast<double>(samples.size() - 1))];
+    };
+    std::printf("round trips: %zu\np50: %.2f us\np99: %.2f us\n"
+                "p99.9: %.2f us\n",
+                samples.size(), at(0.5), at(0.99), at(0.999));
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+    auto const usage = [&] {
+        std::fprintf(stderr,
+                     "usage: %s serve <name> [cpu]\n"
+                     "       %s bench <name> [seconds]\n",
+                     argv[0], argv[0]);
+        return 2;
+    };
+    if (argc < 3 || argc > 4) {
+        return usage();
+    }
+
+    try {
+        std::string_view const command = argv[1];
+        if (command == "serve") {
+            auto const cpu =
+                argc == 4 ? static_cast<int>(tools::parse_count(argv[3], "cpu"))
+                          : -1;
+            serve(argv[2], cpu);
+        } else if (command == "bench") {
+            bench(argv[2],
+                  argc == 4 ? tools::parse_count(argv[3], "seconds") : 5);
+        } else {
+            return usage();
+        }
+    } catch (std::exception const &e) {
+        std::fprintf(stderr, "base_conversion_shm: %s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,33 @@
+#include "base_conversion/calibration.hpp"
+
+#include "arguments.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <string_view>
+
+using namespace evqovv::base_conversion;
+
+auto main(int argc, char **argv) -> int {
+    if (argc != 2 && argc != 3) {
+        std::fprintf(stderr, "usage: %s <profile> [budget-ms]\n", argv[0]);
+        return 2;
+    }
+
+    try {
+        auto const budget = std::chrono::milliseconds(
+            argc == 3 ? tools::parse_count(argv[2], "budget-ms") : 1000);
+        auto const values = tuning::calibrate(budget);
+        tuning::save_profile(argv[1], values);
+
+        for (auto const &entry : tuning::details::crossovers()) {
+            std::printf("%.*s=%zu\n", static_cast<int>(entry.name.size()),
+                        entry.name.data(), values.*entry.field);
+        }
+    } catch (std::exception const &e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+}